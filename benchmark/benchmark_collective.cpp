@@ -0,0 +1,101 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "congestion_aware/Collective.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/SimulationContext.h"
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// buffer size of each NPU
+constexpr auto buffer_size = ChunkSize(64 * 1'048'576);  // 64 MB
+
+/// bundled network configs
+const auto network_names = std::vector<std::string>{"Ring", "Switch", "FullyConnected", "Ring_FullyConnected_Switch"};
+
+/// collectives to compare
+const auto collective_types = std::vector<std::pair<CollectiveType, std::string>>{
+    {CollectiveType::AllReduce, "AllReduce"},
+    {CollectiveType::AllGather, "AllGather"},
+    {CollectiveType::ReduceScatter, "ReduceScatter"},
+    {CollectiveType::AllToAll, "AllToAll"},
+};
+
+/// algorithms to compare
+const auto collective_algorithms = std::vector<std::pair<CollectiveAlgorithm, std::string>>{
+    {CollectiveAlgorithm::Ring, "Ring"},
+    {CollectiveAlgorithm::Tree, "Tree"},
+    {CollectiveAlgorithm::HalvingDoubling, "HalvingDoubling"},
+    {CollectiveAlgorithm::Direct, "Direct"},
+};
+
+/**
+ * Callback invoked when the collective finishes.
+ *
+ * @param arg unused
+ */
+void collective_finished(void* const arg) noexcept {}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    // directory of the bundled network configs
+    const auto input_path = std::string((argc > 1) ? argv[1] : "../../input");
+
+    std::cout << std::setw(28) << "network" << std::setw(15) << "collective" << std::setw(17) << "algorithm"
+              << std::setw(8) << "chunks" << std::setw(16) << "finish (ns)" << std::setw(12) << "events"
+              << std::setw(14) << "Mevents / s" << std::endl;
+
+    for (const auto& network_name : network_names) {
+        const auto network_parser = NetworkParser(input_path + "/" + network_name + ".yml");
+
+        for (const auto& [type, type_name] : collective_types) {
+            for (const auto& [algorithm, algorithm_name] : collective_algorithms) {
+                for (const auto chunks_count : {1, 4, 16}) {
+                    // each run on its own simulation
+                    const auto event_queue = std::make_shared<EventQueue>();
+                    const auto context = std::make_shared<SimulationContext>(event_queue);
+                    const auto topology = construct_topology(network_parser, context);
+                    const auto npus_count = topology->get_npus_count();
+
+                    // halving-doubling runs on power-of-2 NPUs only
+                    if (algorithm == CollectiveAlgorithm::HalvingDoubling && (npus_count & (npus_count - 1)) != 0) {
+                        continue;
+                    }
+
+                    const auto collective = construct_collective(type, algorithm, npus_count, buffer_size, chunks_count);
+
+                    const auto start_time = std::chrono::steady_clock::now();
+                    collective->run(topology.get(), collective_finished, nullptr);
+                    while (!event_queue->finished()) {
+                        event_queue->proceed();
+                    }
+                    const auto end_time = std::chrono::steady_clock::now();
+
+                    const auto elapsed_s = std::chrono::duration<double>(end_time - start_time).count();
+                    const auto events_count = event_queue->get_scheduled_events_count();
+                    std::cout << std::setw(28) << network_name << std::setw(15) << type_name << std::setw(17)
+                              << algorithm_name << std::setw(8) << chunks_count << std::setw(16)
+                              << collective->get_finish_time() << std::setw(12) << events_count << std::setw(14)
+                              << std::fixed << std::setprecision(2) << events_count / elapsed_s / 1e6 << std::endl;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
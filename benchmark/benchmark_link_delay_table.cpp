@@ -0,0 +1,130 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/Type.h"
+#include "congestion_unaware/BasicTopology.h"
+#include "congestion_unaware/FullyConnected.h"
+#include "congestion_unaware/Mesh1D.h"
+#include "congestion_unaware/Ring.h"
+#include "congestion_unaware/Switch.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+
+namespace {
+
+/// number of (src, dest) pairs sent per each building block
+constexpr auto sends_count = 2'000'000;
+
+/// number of times each measurement is repeated, keeping the fastest
+constexpr auto repetitions_count = 5;
+
+/// size of each send
+constexpr auto chunk_size = ChunkSize(1'048'576);  // 1 MB
+
+/// building blocks to compare
+const auto building_blocks = std::vector<std::pair<TopologyBuildingBlock, std::string>>{
+    {TopologyBuildingBlock::Ring, "Ring"},
+    {TopologyBuildingBlock::Mesh1D, "Mesh1D"},
+    {TopologyBuildingBlock::FullyConnected, "FullyConnected"},
+    {TopologyBuildingBlock::Switch, "Switch"},
+};
+
+/// dimension sizes to compare
+const auto npus_counts = std::vector<int>{4, 8, 16, 32, 64, 128, 256};
+
+/**
+ * Construct a building block.
+ *
+ * @param type type of the building block
+ * @param npus_count number of NPUs
+ * @return constructed building block
+ */
+std::unique_ptr<BasicTopology> construct_building_block(const TopologyBuildingBlock type,
+                                                        const int npus_count) noexcept {
+    switch (type) {
+    case TopologyBuildingBlock::Ring:
+        return std::make_unique<Ring>(npus_count, 50, 500);
+    case TopologyBuildingBlock::Mesh1D:
+        return std::make_unique<Mesh1D>(npus_count, 50, 500);
+    case TopologyBuildingBlock::FullyConnected:
+        return std::make_unique<FullyConnected>(npus_count, 50, 500);
+    default:
+        return std::make_unique<Switch>(npus_count, 50, 500);
+    }
+}
+
+/**
+ * Measure the fastest time to send every pair, one at a time.
+ *
+ * @param topology topology to send on
+ * @param srcs src NPU ID per each send
+ * @param dests dest NPU ID per each send
+ * @param total_delay accumulated delay, kept so that the sends aren't optimized out
+ * @return time per send in ns
+ */
+double measure_send(const BasicTopology& topology,
+                    const std::vector<DeviceId>& srcs,
+                    const std::vector<DeviceId>& dests,
+                    EventTime& total_delay) noexcept {
+    auto elapsed_ns = std::numeric_limits<double>::max();
+    for (auto repetition = 0; repetition < repetitions_count; repetition++) {
+        const auto start_time = std::chrono::steady_clock::now();
+        for (auto i = 0; i < sends_count; i++) {
+            total_delay += topology.send(srcs[i], dests[i], chunk_size);
+        }
+        const auto end_time = std::chrono::steady_clock::now();
+        elapsed_ns = std::min(elapsed_ns, std::chrono::duration<double, std::nano>(end_time - start_time).count());
+    }
+    return elapsed_ns / sends_count;
+}
+
+}  // namespace
+
+int main() {
+    std::cout << std::setw(16) << "building block" << std::setw(8) << "NPUs" << std::setw(16) << "ns / computed"
+              << std::setw(16) << "ns / table" << std::endl;
+
+    auto total_delay = EventTime(0);
+    for (const auto& [type, type_name] : building_blocks) {
+        for (const auto npus_count : npus_counts) {
+            // draw random (src, dest) pairs
+            auto random_engine = std::mt19937(0);
+            auto npu_distribution = std::uniform_int_distribution<DeviceId>(0, npus_count - 1);
+            auto srcs = std::vector<DeviceId>();
+            auto dests = std::vector<DeviceId>();
+            while (srcs.size() < sends_count) {
+                const auto src = npu_distribution(random_engine);
+                const auto dest = npu_distribution(random_engine);
+                if (src != dest) {
+                    srcs.push_back(src);
+                    dests.push_back(dest);
+                }
+            }
+
+            // computed hops count, then tabulated link delays
+            auto topology = construct_building_block(type, npus_count);
+            const auto computed_ns = measure_send(*topology, srcs, dests, total_delay);
+            topology->build_link_delay_table();
+            const auto table_ns = measure_send(*topology, srcs, dests, total_delay);
+
+            std::cout << std::setw(16) << type_name << std::setw(8) << npus_count << std::setw(16) << std::fixed
+                      << std::setprecision(1) << computed_ns << std::setw(16) << table_ns << std::endl;
+        }
+    }
+
+    // keep the sends from being optimized out
+    return (total_delay == 0) ? -1 : 0;
+}
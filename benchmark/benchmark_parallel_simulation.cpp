@@ -0,0 +1,145 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/ParallelSimulation.h"
+#include "congestion_aware/SimulationContext.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// number of chunks sent by each NPU
+constexpr auto chunks_per_npu = 64;
+
+/// size of each chunk
+constexpr auto chunk_size = ChunkSize(1'048'576);  // 1 MB
+
+/// numbers of threads to compare
+const auto threads_counts = std::vector<int>{1, 2, 4, 8};
+
+/**
+ * Write a [Mesh1D, VirtualSwitch, SpinalSwitch] network config.
+ *
+ * @param path path of the config file
+ * @param npus_count_per_dim number of NPUs (or leaf nodes) per each dimension
+ */
+void write_network_config(const std::string& path, const std::vector<int>& npus_count_per_dim) noexcept {
+    auto config = std::ofstream(path);
+    config << "topology: [ Mesh1D, VirtualSwitch, SpinalSwitch ]" << std::endl;
+    config << "npus_count: [ " << npus_count_per_dim[0] << ", " << npus_count_per_dim[1] << ", "
+           << npus_count_per_dim[2] << " ]" << std::endl;
+    config << "bandwidth: [ 200, 100, 50 ]" << std::endl;
+    config << "latency: [ 50, 500, 2000 ]" << std::endl;
+}
+
+/**
+ * Callback of arrived chunks, invoked from partition threads.
+ *
+ * @param arg unused
+ */
+void chunk_arrived(void* const arg) noexcept {}
+
+/**
+ * Send the chunks of every (src, dest) pair through the topology.
+ *
+ * @param topology topology to send the chunks through
+ * @param pairs (src, dest) pair of each chunk
+ */
+void send_chunks(const std::shared_ptr<Topology>& topology,
+                 const std::vector<std::pair<DeviceId, DeviceId>>& pairs) noexcept {
+    for (const auto& [src, dest] : pairs) {
+        auto chunk = std::make_unique<Chunk>(chunk_size, 0, topology->route(src, dest), chunk_arrived, nullptr);
+        topology->send(std::move(chunk));
+    }
+}
+
+}  // namespace
+
+int main() {
+    const auto config_path =
+        (std::filesystem::temp_directory_path() / "benchmark_parallel_simulation.yml").string();
+    const auto cluster_shapes = std::vector<std::vector<int>>{{2, 16, 32}, {2, 32, 64}};
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << std::setw(8) << "NPUs" << std::setw(10) << "threads" << std::setw(12) << "partitions"
+              << std::setw(14) << "wall (ms)" << std::setw(10) << "speedup" << std::setw(16) << "finish (ns)"
+              << std::endl;
+
+    for (const auto& npus_count_per_dim : cluster_shapes) {
+        write_network_config(config_path, npus_count_per_dim);
+        const auto network_parser = NetworkParser(config_path);
+
+        // draw random (src, dest) pairs
+        const auto npus_count = npus_count_per_dim[0] * npus_count_per_dim[1] * npus_count_per_dim[2];
+        auto random_engine = std::mt19937(0);
+        auto npu_distribution = std::uniform_int_distribution<DeviceId>(0, npus_count - 1);
+        auto pairs = std::vector<std::pair<DeviceId, DeviceId>>();
+        for (auto src = 0; src < npus_count; src++) {
+            while (pairs.size() < static_cast<size_t>(src + 1) * chunks_per_npu) {
+                const auto dest = npu_distribution(random_engine);
+                if (dest != src) {
+                    pairs.emplace_back(src, dest);
+                }
+            }
+        }
+
+        // sequential simulation as the baseline
+        const auto event_queue = std::make_shared<EventQueue>();
+        const auto topology = construct_topology(network_parser, std::make_shared<SimulationContext>(event_queue));
+        const auto sequential_start_time = std::chrono::steady_clock::now();
+        send_chunks(topology, pairs);
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        const auto sequential_end_time = std::chrono::steady_clock::now();
+        const auto sequential_ms =
+            std::chrono::duration<double, std::milli>(sequential_end_time - sequential_start_time).count();
+        std::cout << std::setw(8) << npus_count << std::setw(10) << "seq" << std::setw(12) << "-" << std::setw(14)
+                  << std::fixed << std::setprecision(1) << sequential_ms << std::setw(10) << std::setprecision(2)
+                  << 1.0 << std::setw(16) << event_queue->get_current_time() << std::endl;
+
+        for (const auto threads_count : threads_counts) {
+            const auto parallel_context = std::make_shared<SimulationContext>(std::make_shared<EventQueue>());
+            const auto parallel_topology = construct_topology(network_parser, parallel_context);
+            auto simulation = ParallelSimulation(parallel_topology, threads_count);
+
+            const auto start_time = std::chrono::steady_clock::now();
+            send_chunks(parallel_topology, pairs);
+            simulation.run();
+            const auto end_time = std::chrono::steady_clock::now();
+
+            // parallel simulations should finish at the bit-identical time
+            if (simulation.get_current_time() != event_queue->get_current_time()) {
+                std::cerr << "[Error] (network/analytical/congestion_aware) "
+                          << "parallel simulation diverged from the sequential one" << std::endl;
+                return -1;
+            }
+
+            const auto elapsed_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+            std::cout << std::setw(8) << npus_count << std::setw(10) << threads_count << std::setw(12)
+                      << simulation.get_partitions_count() << std::setw(14) << std::setprecision(1) << elapsed_ms
+                      << std::setw(10) << std::setprecision(2) << sequential_ms / elapsed_ms << std::setw(16)
+                      << simulation.get_current_time() << std::endl;
+        }
+    }
+
+    std::filesystem::remove(config_path);
+    return 0;
+}
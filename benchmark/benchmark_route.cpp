@@ -0,0 +1,113 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/SimulationContext.h"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// number of (src, dest) pairs routed per each cluster size
+constexpr auto routes_count = 200'000;
+
+/**
+ * Write a multi-dimensional network config.
+ *
+ * @param path path of the config file
+ * @param topologies_per_dim building block per each dimension
+ * @param npus_count_per_dim number of NPUs (or leaf nodes) per each dimension
+ */
+void write_network_config(const std::string& path,
+                          const std::vector<std::string>& topologies_per_dim,
+                          const std::vector<int>& npus_count_per_dim) noexcept {
+    auto topology = std::string();
+    auto npus_count = std::string();
+    auto bandwidth = std::string();
+    auto latency = std::string();
+    for (size_t dim = 0; dim < npus_count_per_dim.size(); dim++) {
+        const auto separator = std::string((dim == 0) ? " " : ", ");
+        topology += separator + topologies_per_dim[dim];
+        npus_count += separator + std::to_string(npus_count_per_dim[dim]);
+        bandwidth += separator + std::to_string(200.0 / (dim + 1));
+        latency += separator + std::to_string(50.0 * (dim + 1));
+    }
+
+    auto config = std::ofstream(path);
+    config << "topology: [" << topology << " ]" << std::endl;
+    config << "npus_count: [" << npus_count << " ]" << std::endl;
+    config << "bandwidth: [" << bandwidth << " ]" << std::endl;
+    config << "latency: [" << latency << " ]" << std::endl;
+}
+
+}  // namespace
+
+int main() {
+    const auto config_path = (std::filesystem::temp_directory_path() / "benchmark_route.yml").string();
+    const auto fat_tree = std::vector<std::string>{"Mesh1D", "VirtualSwitch", "SpinalSwitch"};
+    const auto stack_4d = std::vector<std::string>{"Ring", "FullyConnected", "Switch", "Switch"};
+    const auto stack_5d = std::vector<std::string>{"Mesh1D", "Ring", "FullyConnected", "Switch", "Switch"};
+    const auto cluster_shapes = std::vector<std::pair<std::vector<std::string>, std::vector<int>>>{
+        {fat_tree, {2, 4, 4}},    {fat_tree, {2, 8, 16}},      {fat_tree, {2, 16, 32}},
+        {fat_tree, {2, 32, 64}},  {fat_tree, {2, 64, 128}},    {stack_4d, {4, 8, 8, 16}},
+        {stack_5d, {2, 4, 8, 8, 16}},
+    };
+
+    std::cout << std::setw(6) << "dims" << std::setw(10) << "NPUs" << std::setw(12) << "devices" << std::setw(16)
+              << "ns / route" << std::endl;
+
+    for (const auto& [topologies_per_dim, npus_count_per_dim] : cluster_shapes) {
+        // construct the topology
+        write_network_config(config_path, topologies_per_dim, npus_count_per_dim);
+        const auto context = std::make_shared<SimulationContext>(std::make_shared<EventQueue>());
+        const auto network_parser = NetworkParser(config_path);
+        const auto topology = construct_topology(network_parser, context);
+        const auto npus_count = topology->get_npus_count();
+
+        // draw random (src, dest) pairs
+        auto random_engine = std::mt19937(0);
+        auto npu_distribution = std::uniform_int_distribution<DeviceId>(0, npus_count - 1);
+        auto pairs = std::vector<std::pair<DeviceId, DeviceId>>();
+        while (pairs.size() < routes_count) {
+            const auto src = npu_distribution(random_engine);
+            const auto dest = npu_distribution(random_engine);
+            if (src != dest) {
+                pairs.emplace_back(src, dest);
+            }
+        }
+
+        // route every pair
+        auto hops_count = uint64_t(0);
+        const auto start_time = std::chrono::steady_clock::now();
+        for (const auto& [src, dest] : pairs) {
+            hops_count += topology->route(src, dest).size();
+        }
+        const auto end_time = std::chrono::steady_clock::now();
+
+        const auto elapsed_ns = std::chrono::duration<double, std::nano>(end_time - start_time).count();
+        std::cout << std::setw(6) << topology->get_dims_count() << std::setw(10) << npus_count << std::setw(12) << topology->get_devices_count() << std::setw(16)
+                  << std::fixed << std::setprecision(1) << elapsed_ns / routes_count << std::endl;
+
+        // keep the routes from being optimized out
+        if (hops_count == 0) {
+            return -1;
+        }
+    }
+
+    std::filesystem::remove(config_path);
+    return 0;
+}
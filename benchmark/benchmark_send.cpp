@@ -0,0 +1,153 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/NetworkParser.h"
+#include "congestion_unaware/Helper.h"
+#include "congestion_unaware/StaticMultiDimTopology.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+
+namespace {
+
+/// number of (src, dest) pairs sent per each network shape
+constexpr auto sends_count = 2'000'000;
+
+/// number of times each measurement is repeated, keeping the fastest
+constexpr auto repetitions_count = 5;
+
+/// size of each send
+constexpr auto chunk_size = ChunkSize(1'048'576);  // 1 MB
+
+/**
+ * Write a multi-dimensional network config cycling through Ring, FullyConnected, and Switch.
+ *
+ * @param path path of the config file
+ * @param npus_count_per_dim number of NPUs per each dimension
+ */
+void write_network_config(const std::string& path, const std::vector<int>& npus_count_per_dim) noexcept {
+    const auto building_blocks = std::vector<std::string>{"Ring", "FullyConnected", "Switch"};
+
+    auto topology = std::string();
+    auto npus_count = std::string();
+    auto bandwidth = std::string();
+    auto latency = std::string();
+    for (size_t dim = 0; dim < npus_count_per_dim.size(); dim++) {
+        const auto separator = std::string((dim == 0) ? " " : ", ");
+        topology += separator + building_blocks[dim % building_blocks.size()];
+        npus_count += separator + std::to_string(npus_count_per_dim[dim]);
+        bandwidth += separator + std::to_string(200.0 / (dim + 1));
+        latency += separator + std::to_string(50.0 * (dim + 1));
+    }
+
+    auto config = std::ofstream(path);
+    config << "topology: [" << topology << " ]" << std::endl;
+    config << "npus_count: [" << npus_count << " ]" << std::endl;
+    config << "bandwidth: [" << bandwidth << " ]" << std::endl;
+    config << "latency: [" << latency << " ]" << std::endl;
+}
+
+}  // namespace
+
+int main() {
+    const auto config_path = (std::filesystem::temp_directory_path() / "benchmark_send.yml").string();
+    const auto network_shapes =
+        std::vector<std::vector<int>>{{16}, {2, 8, 4}, {8, 16, 32}, {4, 8, 8, 16}, {2, 4, 8, 8, 16}};
+
+    std::cout << std::setw(10) << "NPUs" << std::setw(8) << "dims" << std::setw(14) << "ns / send" << std::setw(14)
+              << "ns / batched" << std::setw(14) << "ns / static" << std::endl;
+
+    for (const auto& npus_count_per_dim : network_shapes) {
+        // construct the topology
+        write_network_config(config_path, npus_count_per_dim);
+        const auto network_parser = NetworkParser(config_path);
+        const auto topology = construct_topology(network_parser);
+        const auto static_topology = construct_static_topology(network_parser);
+        const auto npus_count = topology->get_npus_count();
+
+        // draw random (src, dest) pairs
+        auto random_engine = std::mt19937(0);
+        auto npu_distribution = std::uniform_int_distribution<DeviceId>(0, npus_count - 1);
+        auto srcs = std::vector<DeviceId>();
+        auto dests = std::vector<DeviceId>();
+        while (srcs.size() < sends_count) {
+            const auto src = npu_distribution(random_engine);
+            const auto dest = npu_distribution(random_engine);
+            if (src != dest) {
+                srcs.push_back(src);
+                dests.push_back(dest);
+            }
+        }
+        const auto chunk_sizes = std::vector<ChunkSize>(sends_count, chunk_size);
+
+        auto total_delay = EventTime(0);
+        auto delays = std::vector<EventTime>(sends_count);
+        auto elapsed_ns = std::numeric_limits<double>::max();
+        auto batch_elapsed_ns = std::numeric_limits<double>::max();
+        auto static_elapsed_ns = std::numeric_limits<double>::max();
+        for (auto repetition = 0; repetition < repetitions_count; repetition++) {
+            // send every pair, one at a time
+            const auto start_time = std::chrono::steady_clock::now();
+            for (auto i = 0; i < sends_count; i++) {
+                total_delay += topology->send(srcs[i], dests[i], chunk_size);
+            }
+            const auto end_time = std::chrono::steady_clock::now();
+
+            // send every pair at once
+            topology->send_batch(srcs.data(), dests.data(), chunk_sizes.data(), delays.data(), sends_count);
+            const auto batch_end_time = std::chrono::steady_clock::now();
+
+            elapsed_ns = std::min(elapsed_ns, std::chrono::duration<double, std::nano>(end_time - start_time).count());
+            batch_elapsed_ns = std::min(
+                batch_elapsed_ns, std::chrono::duration<double, std::nano>(batch_end_time - end_time).count());
+
+            // send every pair one at a time, through the pre-instantiated shape if any
+            if (static_topology.has_value()) {
+                std::visit(
+                    [&](const auto& static_topology) noexcept {
+                        auto static_total_delay = EventTime(0);
+                        const auto static_start_time = std::chrono::steady_clock::now();
+                        for (auto i = 0; i < sends_count; i++) {
+                            static_total_delay += static_topology.send(srcs[i], dests[i], chunk_size);
+                        }
+                        const auto static_end_time = std::chrono::steady_clock::now();
+                        total_delay += static_total_delay;
+                        static_elapsed_ns = std::min(
+                            static_elapsed_ns,
+                            std::chrono::duration<double, std::nano>(static_end_time - static_start_time).count());
+                    },
+                    *static_topology);
+            }
+        }
+        std::cout << std::setw(10) << npus_count << std::setw(8) << topology->get_dims_count() << std::setw(14)
+                  << std::fixed << std::setprecision(1) << elapsed_ns / sends_count << std::setw(14)
+                  << batch_elapsed_ns / sends_count << std::setw(14);
+        if (static_topology.has_value()) {
+            std::cout << static_elapsed_ns / sends_count << std::endl;
+        } else {
+            std::cout << "-" << std::endl;
+        }
+
+        // keep the sends from being optimized out
+        if (total_delay == 0 || delays.back() == 0) {
+            return -1;
+        }
+    }
+
+    std::filesystem::remove(config_path);
+    return 0;
+}
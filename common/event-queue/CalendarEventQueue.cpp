@@ -0,0 +1,179 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/CalendarEventQueue.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+CalendarEventQueue::CalendarEventQueue(MemoryPool* const memory_pool) noexcept
+    : memory_pool(memory_pool),
+      bucket_width(1),
+      event_lists_count(0),
+      last_bucket(0),
+      bucket_top(1),
+      last_event_time(0) {
+    assert(memory_pool != nullptr);
+
+    // create empty buckets
+    buckets = std::vector<Bucket>(min_buckets_count, Bucket(PoolAllocator<EventList>(memory_pool)));
+}
+
+bool CalendarEventQueue::empty() const noexcept {
+    return event_lists_count == 0;
+}
+
+void CalendarEventQueue::schedule_event(const EventTime event_time,
+                                        const Callback callback,
+                                        const CallbackArg callback_arg) noexcept {
+    // calendar queue is monotone: events cannot be scheduled in the past
+    assert(event_time >= last_event_time);
+
+    // find the entry to insert event inside the bucket
+    auto& bucket = buckets[bucket_index(event_time)];
+    auto event_list_it = bucket.begin();
+    while (event_list_it != bucket.end() && event_list_it->get_event_time() < event_time) {
+        event_list_it++;
+    }
+
+    // create a new event list if there's no one matching with event_time
+    if (event_list_it == bucket.end() || event_time < event_list_it->get_event_time()) {
+        event_list_it = bucket.insert(event_list_it, EventList(event_time, memory_pool));
+        event_lists_count++;
+    }
+
+    // add event to event_list
+    event_list_it->add_event(callback, callback_arg);
+
+    // grow the calendar if buckets become too crowded
+    if (event_lists_count > 2 * buckets.size()) {
+        resize(2 * buckets.size());
+    }
+}
+
+EventList CalendarEventQueue::pop_front() noexcept {
+    assert(!empty());
+
+    // move to the bucket holding the earliest event list
+    locate_front();
+
+    // detach the event list
+    auto& bucket = buckets[last_bucket];
+    auto event_list = std::move(bucket.front());
+    bucket.pop_front();
+    event_lists_count--;
+    last_event_time = event_list.get_event_time();
+
+    // shrink the calendar if buckets become too sparse
+    if (buckets.size() > min_buckets_count && event_lists_count < buckets.size() / 2) {
+        resize(buckets.size() / 2);
+    }
+
+    return event_list;
+}
+
+size_t CalendarEventQueue::bucket_index(const EventTime event_time) const noexcept {
+    // buckets count is always a power of 2
+    return static_cast<size_t>(event_time / bucket_width) & (buckets.size() - 1);
+}
+
+void CalendarEventQueue::locate_front() noexcept {
+    assert(!empty());
+
+    // scan a year of buckets, starting from the last popped one
+    for (size_t i = 0; i < buckets.size(); i++) {
+        const auto& bucket = buckets[last_bucket];
+        if (!bucket.empty() && bucket.front().get_event_time() < bucket_top) {
+            return;
+        }
+
+        // move to the next day
+        last_bucket = (last_bucket + 1) & (buckets.size() - 1);
+        bucket_top += bucket_width;
+    }
+
+    // no event within a year: directly search the earliest event list
+    auto earliest_time = EventTime(0);
+    auto found = false;
+    for (const auto& bucket : buckets) {
+        if (!bucket.empty() && (!found || bucket.front().get_event_time() < earliest_time)) {
+            earliest_time = bucket.front().get_event_time();
+            found = true;
+        }
+    }
+    assert(found);
+
+    last_bucket = bucket_index(earliest_time);
+    bucket_top = (earliest_time / bucket_width + 1) * bucket_width;
+}
+
+void CalendarEventQueue::resize(const size_t new_buckets_count) noexcept {
+    assert(new_buckets_count >= min_buckets_count);
+    assert((new_buckets_count & (new_buckets_count - 1)) == 0);
+
+    // collect every event list
+    auto event_lists = Bucket(PoolAllocator<EventList>(memory_pool));
+    for (auto& bucket : buckets) {
+        event_lists.splice(event_lists.end(), bucket);
+    }
+
+    // re-estimate bucket width
+    auto event_times = std::vector<EventTime>();
+    event_times.reserve(event_lists.size());
+    for (const auto& event_list : event_lists) {
+        event_times.push_back(event_list.get_event_time());
+    }
+    bucket_width = estimate_bucket_width(std::move(event_times));
+
+    // rebuild buckets
+    buckets = std::vector<Bucket>(new_buckets_count, Bucket(PoolAllocator<EventList>(memory_pool)));
+    while (!event_lists.empty()) {
+        const auto event_time = event_lists.front().get_event_time();
+        auto& bucket = buckets[bucket_index(event_time)];
+
+        // keep each bucket sorted, event times are unique across event lists
+        auto it = bucket.begin();
+        while (it != bucket.end() && it->get_event_time() < event_time) {
+            it++;
+        }
+        bucket.splice(it, event_lists, event_lists.begin());
+    }
+
+    // restart scanning from the last popped event time
+    last_bucket = bucket_index(last_event_time);
+    bucket_top = (last_event_time / bucket_width + 1) * bucket_width;
+}
+
+EventTime CalendarEventQueue::estimate_bucket_width(std::vector<EventTime> event_times) noexcept {
+    if (event_times.size() < 2) {
+        return 1;
+    }
+
+    // sort the earliest event times
+    const auto samples_count = std::min(event_times.size(), width_samples_count);
+    std::partial_sort(event_times.begin(), event_times.begin() + samples_count, event_times.end());
+
+    // average gap between the earliest event times
+    const auto span = event_times[samples_count - 1] - event_times[0];
+    const auto average_gap = span / (samples_count - 1);
+
+    // discard outlying gaps and re-compute the average
+    auto gaps_sum = EventTime(0);
+    auto gaps_count = EventTime(0);
+    for (size_t i = 1; i < samples_count; i++) {
+        const auto gap = event_times[i] - event_times[i - 1];
+        if (gap <= 2 * average_gap) {
+            gaps_sum += gap;
+            gaps_count++;
+        }
+    }
+
+    if (gaps_count == 0 || gaps_sum == 0) {
+        return std::max(average_gap * 3, EventTime(1));
+    }
+
+    return std::max(3 * gaps_sum / gaps_count, EventTime(1));
+}
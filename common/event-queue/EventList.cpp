@@ -8,11 +8,10 @@ LICENSE file in the root directory of this source tree.
 
 using namespace NetworkAnalytical;
 
-EventList::EventList(const EventTime event_time) noexcept : event_time(event_time) {
+EventList::EventList(const EventTime event_time, MemoryPool* const memory_pool) noexcept
+    : event_time(event_time),
+      events(PoolAllocator<Event>(memory_pool)) {
     assert(event_time >= 0);
-
-    // create an empty event list
-    events = std::list<Event>();
 }
 
 EventTime EventList::get_event_time() const noexcept {
@@ -4,13 +4,35 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "common/EventQueue.h"
+#include "common/CalendarEventQueue.h"
+#include "common/HeapEventQueue.h"
+#include "common/ListEventQueue.h"
 #include <cassert>
+#include <cstdlib>
+#include <iostream>
 
 using namespace NetworkAnalytical;
 
-EventQueue::EventQueue() noexcept : current_time(0) {
+EventQueue::EventQueue(const EventQueueType event_queue_type) noexcept
+    : current_time(0),
+      scheduled_events_count(0),
+      current_event_list(nullptr) {
     // create empty event queue
-    event_queue = std::list<EventList>();
+    switch (event_queue_type) {
+    case EventQueueType::List:
+        event_queue = std::make_unique<ListEventQueue>(&memory_pool);
+        break;
+    case EventQueueType::Calendar:
+        event_queue = std::make_unique<CalendarEventQueue>(&memory_pool);
+        break;
+    case EventQueueType::Heap:
+        event_queue = std::make_unique<HeapEventQueue>(&memory_pool);
+        break;
+    default:
+        // shouldn't reach here
+        std::cerr << "[Error] (network/analytical) " << "not supported event queue type" << std::endl;
+        std::exit(-1);
+    }
 }
 
 EventTime EventQueue::get_current_time() const noexcept {
@@ -19,7 +41,7 @@ EventTime EventQueue::get_current_time() const noexcept {
 
 bool EventQueue::finished() const noexcept {
     // check whether event queue is empty
-    return event_queue.empty();
+    return event_queue->empty();
 }
 
 void EventQueue::proceed() noexcept {
@@ -27,17 +49,18 @@ void EventQueue::proceed() noexcept {
     assert(!finished());
 
     // proceed to the next event time
-    auto& current_event_list = event_queue.front();
+    auto event_list = event_queue->pop_front();
 
     // check the validity and update current time
-    assert(current_event_list.get_event_time() > current_time);
-    current_time = current_event_list.get_event_time();
+    // events may have been scheduled at current_time in between proceed() calls
+    assert(event_list.get_event_time() >= current_time);
+    current_time = event_list.get_event_time();
 
     // invoke events
-    current_event_list.invoke_events();
-
-    // drop processed event list
-    event_queue.pop_front();
+    // events newly scheduled at current_time are merged into this event list
+    current_event_list = &event_list;
+    event_list.invoke_events();
+    current_event_list = nullptr;
 }
 
 void EventQueue::schedule_event(const EventTime event_time,
@@ -46,26 +69,22 @@ void EventQueue::schedule_event(const EventTime event_time,
     // time should be at least larger than current time
     assert(event_time >= current_time);
 
-    // find the entry to insert event
-    auto event_list_it = event_queue.begin();
-    while (event_list_it != event_queue.end() && event_list_it->get_event_time() < event_time) {
-        event_list_it++;
-    }
+    scheduled_events_count++;
 
-    // There can be three scenarios:
-    // (1) event list matching with event_time is found
-    // (2) there's no event list matching with event_time
-    //   (2-1) the event_time requested is
-    //   larger than the largest event time scheduled
-    //   (2-2) the event_time requested is
-    //   smaller than the largest event time scheduled
-    // for both (2-1) or (2-2), a new event should be created
-    if (event_list_it == event_queue.end() || event_time < event_list_it->get_event_time()) {
-        // insert new event_list
-        event_list_it = event_queue.insert(event_list_it, EventList(event_time));
+    // the event list of current_time is being invoked
+    if (current_event_list != nullptr && event_time == current_time) {
+        current_event_list->add_event(callback, callback_arg);
+        return;
     }
 
-    // now, whether (1) or (2), the entry to insert the event is found
-    // add event to event_list
-    event_list_it->add_event(callback, callback_arg);
+    // register the event to the backend
+    event_queue->schedule_event(event_time, callback, callback_arg);
+}
+
+uint64_t EventQueue::get_scheduled_events_count() const noexcept {
+    return scheduled_events_count;
+}
+
+const MemoryPool& EventQueue::get_memory_pool() const noexcept {
+    return memory_pool;
 }
@@ -0,0 +1,107 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/HeapEventQueue.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+HeapEventQueue::HeapEventQueue(MemoryPool* const memory_pool) noexcept
+    : memory_pool(memory_pool),
+      event_lists(0, std::hash<EventTime>(), std::equal_to<EventTime>(), PoolAllocator<EventList>(memory_pool)) {
+    assert(memory_pool != nullptr);
+
+    // create empty heap
+    event_times = std::vector<EventTime>();
+}
+
+bool HeapEventQueue::empty() const noexcept {
+    return event_times.empty();
+}
+
+void HeapEventQueue::schedule_event(const EventTime event_time,
+                                    const Callback callback,
+                                    const CallbackArg callback_arg) noexcept {
+    // find the event list matching with event_time
+    auto event_list_it = event_lists.find(event_time);
+
+    if (event_list_it == event_lists.end()) {
+        // create a new event list and push its time into the heap
+        event_list_it = event_lists.emplace(event_time, EventList(event_time, memory_pool)).first;
+        event_times.push_back(event_time);
+        sift_up(event_times.size() - 1);
+    }
+
+    // add event to event_list
+    event_list_it->second.add_event(callback, callback_arg);
+}
+
+EventList HeapEventQueue::pop_front() noexcept {
+    assert(!empty());
+
+    // detach the event list of the earliest event time
+    const auto event_time = event_times.front();
+    auto event_list_it = event_lists.find(event_time);
+    assert(event_list_it != event_lists.end());
+    auto event_list = std::move(event_list_it->second);
+    event_lists.erase(event_list_it);
+
+    // pop the earliest event time from the heap
+    event_times.front() = event_times.back();
+    event_times.pop_back();
+    if (!event_times.empty()) {
+        sift_down(0);
+    }
+
+    return event_list;
+}
+
+void HeapEventQueue::sift_up(size_t index) noexcept {
+    assert(index < event_times.size());
+
+    const auto event_time = event_times[index];
+    while (index > 0) {
+        const auto parent = (index - 1) / arity;
+        if (event_times[parent] <= event_time) {
+            break;
+        }
+
+        // move parent down
+        event_times[index] = event_times[parent];
+        index = parent;
+    }
+    event_times[index] = event_time;
+}
+
+void HeapEventQueue::sift_down(size_t index) noexcept {
+    assert(index < event_times.size());
+
+    const auto size = event_times.size();
+    const auto event_time = event_times[index];
+    while (true) {
+        // find the smallest child
+        const auto first_child = arity * index + 1;
+        if (first_child >= size) {
+            break;
+        }
+        auto smallest_child = first_child;
+        const auto last_child = std::min(first_child + arity, size);
+        for (auto child = first_child + 1; child < last_child; child++) {
+            if (event_times[child] < event_times[smallest_child]) {
+                smallest_child = child;
+            }
+        }
+
+        if (event_time <= event_times[smallest_child]) {
+            break;
+        }
+
+        // move the smallest child up
+        event_times[index] = event_times[smallest_child];
+        index = smallest_child;
+    }
+    event_times[index] = event_time;
+}
@@ -0,0 +1,56 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/ListEventQueue.h"
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+ListEventQueue::ListEventQueue(MemoryPool* const memory_pool) noexcept
+    : memory_pool(memory_pool),
+      event_queue(PoolAllocator<EventList>(memory_pool)) {
+    assert(memory_pool != nullptr);
+}
+
+bool ListEventQueue::empty() const noexcept {
+    return event_queue.empty();
+}
+
+void ListEventQueue::schedule_event(const EventTime event_time,
+                                    const Callback callback,
+                                    const CallbackArg callback_arg) noexcept {
+    // find the entry to insert event
+    auto event_list_it = event_queue.begin();
+    while (event_list_it != event_queue.end() && event_list_it->get_event_time() < event_time) {
+        event_list_it++;
+    }
+
+    // There can be three scenarios:
+    // (1) event list matching with event_time is found
+    // (2) there's no event list matching with event_time
+    //   (2-1) the event_time requested is
+    //   larger than the largest event time scheduled
+    //   (2-2) the event_time requested is
+    //   smaller than the largest event time scheduled
+    // for both (2-1) or (2-2), a new event should be created
+    if (event_list_it == event_queue.end() || event_time < event_list_it->get_event_time()) {
+        // insert new event_list
+        event_list_it = event_queue.insert(event_list_it, EventList(event_time, memory_pool));
+    }
+
+    // now, whether (1) or (2), the entry to insert the event is found
+    // add event to event_list
+    event_list_it->add_event(callback, callback_arg);
+}
+
+EventList ListEventQueue::pop_front() noexcept {
+    assert(!empty());
+
+    // detach the first event list
+    auto event_list = std::move(event_queue.front());
+    event_queue.pop_front();
+
+    return event_list;
+}
@@ -0,0 +1,116 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/MemoryPool.h"
+#include <cassert>
+#include <new>
+
+using namespace NetworkAnalytical;
+
+MemoryPool::MemoryPool() noexcept
+    : heap_allocations_count(0),
+      allocations_count(0),
+      live_blocks_count(0),
+      peak_live_blocks_count(0) {
+    // every free list starts empty
+    free_lists.fill(nullptr);
+    slabs = std::vector<void*>();
+}
+
+MemoryPool::~MemoryPool() noexcept {
+    // release slabs
+    for (auto* const slab : slabs) {
+        ::operator delete(slab);
+    }
+}
+
+void* MemoryPool::allocate(const size_t size) noexcept {
+    assert(size > 0);
+
+    // update statistics
+    allocations_count++;
+    live_blocks_count++;
+    if (live_blocks_count > peak_live_blocks_count) {
+        peak_live_blocks_count = live_blocks_count;
+    }
+
+    // too large for size classes, allocate from the heap
+    if (size > max_block_size) {
+        heap_allocations_count++;
+        return ::operator new(size);
+    }
+
+    // take a block from the free list, refilling it if empty
+    const auto index = size_class(size);
+    if (free_lists[index] == nullptr) {
+        refill(index);
+    }
+    auto* const block = free_lists[index];
+    free_lists[index] = block->next;
+
+    return static_cast<void*>(block);
+}
+
+void MemoryPool::deallocate(void* const ptr, const size_t size) noexcept {
+    assert(ptr != nullptr);
+    assert(live_blocks_count > 0);
+
+    // update statistics
+    live_blocks_count--;
+
+    // too large for size classes, return to the heap
+    if (size > max_block_size) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    // push the block back to the free list
+    const auto index = size_class(size);
+    auto* const block = static_cast<FreeBlock*>(ptr);
+    block->next = free_lists[index];
+    free_lists[index] = block;
+}
+
+uint64_t MemoryPool::get_heap_allocations_count() const noexcept {
+    return heap_allocations_count;
+}
+
+uint64_t MemoryPool::get_allocations_count() const noexcept {
+    return allocations_count;
+}
+
+uint64_t MemoryPool::get_live_blocks_count() const noexcept {
+    return live_blocks_count;
+}
+
+uint64_t MemoryPool::get_peak_live_blocks_count() const noexcept {
+    return peak_live_blocks_count;
+}
+
+size_t MemoryPool::size_class(const size_t size) noexcept {
+    assert(0 < size && size <= max_block_size);
+
+    // e.g., with 16B alignment, 1-16B -> 0, 17-32B -> 1, ...
+    return (size - 1) / block_alignment;
+}
+
+void MemoryPool::refill(const size_t size_class_index) noexcept {
+    assert(size_class_index < size_classes_count);
+    assert(free_lists[size_class_index] == nullptr);
+
+    // allocate a new slab
+    auto* const slab = static_cast<char*>(::operator new(slab_size));
+    slabs.push_back(slab);
+    heap_allocations_count++;
+
+    // carve the slab into blocks, and link them into the free list
+    const auto block_size = (size_class_index + 1) * block_alignment;
+    const auto blocks_count = slab_size / block_size;
+    for (auto i = blocks_count; i > 0; i--) {
+        auto* const block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * block_size);
+        block->next = free_lists[size_class_index];
+        free_lists[size_class_index] = block;
+    }
+}
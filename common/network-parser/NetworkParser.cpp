@@ -9,7 +9,7 @@ LICENSE file in the root directory of this source tree.
 
 using namespace NetworkAnalytical;
 
-NetworkParser::NetworkParser(const std::string& path) noexcept : dims_count(-1) {
+NetworkParser::NetworkParser(const std::string& path) noexcept : dims_count(-1), packet_size(0) {
     // initialize values
     npus_count_per_dim = {};
     bandwidth_per_dim = {};
@@ -63,6 +63,10 @@ std::vector<TopologyBuildingBlock> NetworkParser::get_topologies_per_dim() const
     return topology_per_dim;
 }
 
+ChunkSize NetworkParser::get_packet_size() const noexcept {
+    return packet_size;
+}
+
 void NetworkParser::parse_network_config_yml(const YAML::Node& network_config) noexcept {
     // parse topology_per_dim
     const auto topology_names = parse_vector<std::string>(network_config["topology"]);
@@ -79,6 +83,17 @@ void NetworkParser::parse_network_config_yml(const YAML::Node& network_config) n
     bandwidth_per_dim = parse_vector<Bandwidth>(network_config["bandwidth"]);
     latency_per_dim = parse_vector<Latency>(network_config["latency"]);
 
+    // parse optional values
+    if (network_config["packet_size"]) {
+        try {
+            packet_size = network_config["packet_size"].as<ChunkSize>();
+        } catch (const YAML::BadConversion& e) {
+            std::cerr << "[Error] (network/analytical) " << "packet_size should be a non-negative integer"
+                      << std::endl;
+            std::exit(-1);
+        }
+    }
+
     // check the validity of the parsed network config
     check_validity();
 }
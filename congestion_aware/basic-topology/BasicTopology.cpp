@@ -12,11 +12,13 @@ using namespace NetworkAnalyticalCongestionAware;
 BasicTopology::BasicTopology(const int npus_count,
                              const int devices_count,
                              const Bandwidth bandwidth,
-                             const Latency latency, const int base_id) noexcept
+                             const Latency latency,
+                             const int base_id,
+                             std::shared_ptr<SimulationContext> context) noexcept
     : bandwidth(bandwidth),
       latency(latency),
       basic_topology_type(TopologyBuildingBlock::Undefined),
-      Topology(base_id) {
+      Topology(base_id, std::move(context)) {
     assert(npus_count >= 0);
     assert(devices_count >= 0);
     assert(devices_count >= npus_count);
@@ -8,8 +8,12 @@ LICENSE file in the root directory of this source tree.
 
 using namespace NetworkAnalyticalCongestionAware;
 
-FullyConnected::FullyConnected(const int npus_count, const Bandwidth bandwidth, const Latency latency, const int base_id) noexcept
-    : BasicTopology(npus_count, npus_count, bandwidth, latency, base_id) {
+FullyConnected::FullyConnected(const int npus_count,
+                               const Bandwidth bandwidth,
+                               const Latency latency,
+                               const int base_id,
+                               std::shared_ptr<SimulationContext> context) noexcept
+    : BasicTopology(npus_count, npus_count, bandwidth, latency, base_id, std::move(context)) {
     assert(npus_count > 0);
     assert(bandwidth > 0);
     assert(latency >= 0);
@@ -27,7 +31,7 @@ FullyConnected::FullyConnected(const int npus_count, const Bandwidth bandwidth,
     }
 }
 
-Route FullyConnected::route(const DeviceId src, const DeviceId dest) const noexcept {
+Route FullyConnected::compute_route(const DeviceId src, const DeviceId dest) const noexcept {
     // assert npus are in valid range
     assert(0 <= src && src < npus_count);
     assert(0 <= dest && dest < npus_count);
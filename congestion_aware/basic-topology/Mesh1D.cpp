@@ -11,8 +11,12 @@ using namespace NetworkAnalyticalCongestionAware;
 
 // base_id is the global id of the first device in the mesh
 
-Mesh1D::Mesh1D(const int npus_count, const Bandwidth bandwidth, const Latency latency, const int base_id) noexcept
-    : BasicTopology(npus_count, npus_count, bandwidth, latency, base_id) {
+Mesh1D::Mesh1D(const int npus_count,
+               const Bandwidth bandwidth,
+               const Latency latency,
+               const int base_id,
+               std::shared_ptr<SimulationContext> context) noexcept
+    : BasicTopology(npus_count, npus_count, bandwidth, latency, base_id, std::move(context)) {
     assert(npus_count > 0);
     assert(bandwidth > 0);
     assert(latency >= 0);
@@ -20,9 +24,6 @@ Mesh1D::Mesh1D(const int npus_count, const Bandwidth bandwidth, const Latency la
     // set topology type
     basic_topology_type = TopologyBuildingBlock::Mesh1D;
 
-    // calculate the size of the 1D array
-    assert(npus_count == 2);
-
     // connect npus in a 1D mesh
     for (auto i = 0; i < npus_count; i++) {
         if (i + 1 < npus_count) {
@@ -31,7 +32,7 @@ Mesh1D::Mesh1D(const int npus_count, const Bandwidth bandwidth, const Latency la
     }
 }
 
-Route Mesh1D::route(DeviceId global_src, DeviceId global_dest) const noexcept {
+Route Mesh1D::compute_route(DeviceId global_src, DeviceId global_dest) const noexcept {
     assert(contains_device(global_src));
     assert(contains_device(global_dest));
 
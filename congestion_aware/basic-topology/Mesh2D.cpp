@@ -9,8 +9,12 @@ LICENSE file in the root directory of this source tree.
 #include <iostream>
 using namespace NetworkAnalyticalCongestionAware;
 
-Mesh2D::Mesh2D(const int npus_count, const Bandwidth bandwidth, const Latency latency, const int base_id) noexcept
-    : BasicTopology(npus_count, npus_count, bandwidth, latency, base_id) {
+Mesh2D::Mesh2D(const int npus_count,
+               const Bandwidth bandwidth,
+               const Latency latency,
+               const int base_id,
+               std::shared_ptr<SimulationContext> context) noexcept
+    : BasicTopology(npus_count, npus_count, bandwidth, latency, base_id, std::move(context)) {
     assert(npus_count > 0);
     assert(bandwidth > 0);
     assert(latency >= 0);
@@ -52,7 +56,7 @@ Mesh2D::Mesh2D(const int npus_count, const Bandwidth bandwidth, const Latency la
     }
 }
 
-Route Mesh2D::route(DeviceId src, DeviceId dest) const noexcept {
+Route Mesh2D::compute_route(DeviceId src, DeviceId dest) const noexcept {
     assert(contains_device(src));
     assert(contains_device(dest));
 
@@ -8,13 +8,21 @@ LICENSE file in the root directory of this source tree.
 
 using namespace NetworkAnalyticalCongestionAware;
 
-Ring::Ring(const int npus_count, const Bandwidth bandwidth, const Latency latency, const bool bidirectional, const int base_id) noexcept
+Ring::Ring(const int npus_count,
+           const Bandwidth bandwidth,
+           const Latency latency,
+           const bool bidirectional,
+           const int base_id,
+           std::shared_ptr<SimulationContext> context) noexcept
     : bidirectional(bidirectional),
-      BasicTopology(npus_count, npus_count, bandwidth, latency, base_id) {
+      BasicTopology(npus_count, npus_count, bandwidth, latency, base_id, std::move(context)) {
     assert(npus_count > 0);
     assert(bandwidth > 0);
     assert(latency >= 0);
 
+    // set topology type
+    basic_topology_type = TopologyBuildingBlock::Ring;
+
     // connect npus in a ring
     for (auto i = 0; i < npus_count - 1; i++) {
         connect(i, i + 1, bandwidth, latency, bidirectional, false);
@@ -22,7 +30,7 @@ Ring::Ring(const int npus_count, const Bandwidth bandwidth, const Latency latenc
     connect(npus_count - 1, 0, bandwidth, latency, bidirectional);
 }
 
-Route Ring::route(DeviceId src, DeviceId dest) const noexcept {
+Route Ring::compute_route(DeviceId src, DeviceId dest) const noexcept {
     // assert npus are in valid range
     assert(0 <= src && src < npus_count);
     assert(0 <= dest && dest < npus_count);
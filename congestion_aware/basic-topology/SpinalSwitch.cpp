@@ -21,8 +21,12 @@ switch0 switch1 switch2 switch3
 @param base_id: base id of the topology
 */
 
-SpinalSwitch::SpinalSwitch(const int leaf_nodes_count, const Bandwidth bandwidth, const Latency latency, const int base_id) noexcept
-    : BasicTopology(0, leaf_nodes_count+1, bandwidth, latency, base_id) {
+SpinalSwitch::SpinalSwitch(const int leaf_nodes_count,
+                           const Bandwidth bandwidth,
+                           const Latency latency,
+                           const int base_id,
+                           std::shared_ptr<SimulationContext> context) noexcept
+    : BasicTopology(0, leaf_nodes_count+1, bandwidth, latency, base_id, std::move(context)) {
     
     // there ar no npus in this topology, only spinal switch
     assert(leaf_nodes_count > 0);
@@ -40,7 +44,7 @@ SpinalSwitch::SpinalSwitch(const int leaf_nodes_count, const Bandwidth bandwidth
     }
 }
 
-Route SpinalSwitch::route(DeviceId global_src, DeviceId global_dest) const noexcept {
+Route SpinalSwitch::compute_route(DeviceId global_src, DeviceId global_dest) const noexcept {
 
     assert(contains_device(global_src));
     assert(contains_device(global_dest));
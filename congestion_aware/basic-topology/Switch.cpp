@@ -8,14 +8,21 @@ LICENSE file in the root directory of this source tree.
 
 using namespace NetworkAnalyticalCongestionAware;
 
-Switch::Switch(const int npus_count, const Bandwidth bandwidth, const Latency latency, const int base_id) noexcept
-    : BasicTopology(npus_count, npus_count + 1, bandwidth, latency, base_id) {
+Switch::Switch(const int npus_count,
+               const Bandwidth bandwidth,
+               const Latency latency,
+               const int base_id,
+               std::shared_ptr<SimulationContext> context) noexcept
+    : BasicTopology(npus_count, npus_count + 1, bandwidth, latency, base_id, std::move(context)) {
     // e.g., if npus_count=8, then
     // there are total 9 devices, where ordinary npus are 0-7, and switch is 8
     assert(npus_count > 0);
     assert(bandwidth > 0);
     assert(latency >= 0);
 
+    // set topology type
+    basic_topology_type = TopologyBuildingBlock::Switch;
+
     // set switch id
     switch_id = npus_count;
 
@@ -25,7 +32,7 @@ Switch::Switch(const int npus_count, const Bandwidth bandwidth, const Latency la
     }
 }
 
-Route Switch::route(DeviceId src, DeviceId dest) const noexcept {
+Route Switch::compute_route(DeviceId src, DeviceId dest) const noexcept {
     // assert npus are in valid range
     assert(0 <= src && src < npus_count);
     assert(0 <= dest && dest < npus_count);
@@ -9,9 +9,13 @@ LICENSE file in the root directory of this source tree.
 
 using namespace NetworkAnalyticalCongestionAware;
 
-Tree::Tree(const int npus_count, const Bandwidth bandwidth, const Latency latency, const int base_id) noexcept
+Tree::Tree(const int npus_count,
+           const Bandwidth bandwidth,
+           const Latency latency,
+           const int base_id,
+           std::shared_ptr<SimulationContext> context) noexcept
     : bidirectional(true),
-      BasicTopology(0, npus_count, bandwidth, latency, base_id) {
+      BasicTopology(0, npus_count, bandwidth, latency, base_id, std::move(context)) {
     assert(npus_count > 0);
     assert(bandwidth > 0);
     assert(latency >= 0);
@@ -37,7 +41,7 @@ Tree::Tree(const int npus_count, const Bandwidth bandwidth, const Latency latenc
 
 }
 
-Route Tree::route(DeviceId src, DeviceId dest) const noexcept {
+Route Tree::compute_route(DeviceId src, DeviceId dest) const noexcept {
     // assert npus are in valid range
     assert(src >= 13 && src <= 28);
     assert(dest >= 13 && dest <= 28);
@@ -21,8 +21,12 @@ virtual-switch0 virtual-switch1 virtual-switch2 virtual-switch3
 @param base_id: base id of the topology
 */
 
-VirtualSwitch::VirtualSwitch(const int leaf_nodes_count, const Bandwidth bandwidth, const Latency latency, const int base_id) noexcept
-    : BasicTopology(0, 0, bandwidth, latency, base_id) {
+VirtualSwitch::VirtualSwitch(const int leaf_nodes_count,
+                             const Bandwidth bandwidth,
+                             const Latency latency,
+                             const int base_id,
+                             std::shared_ptr<SimulationContext> context) noexcept
+    : BasicTopology(0, 0, bandwidth, latency, base_id, std::move(context)) {
     
     // there ar no npus in this topology, only virtual switch
     assert(leaf_nodes_count > 0);
@@ -39,7 +43,7 @@ int VirtualSwitch::get_leaf_nodes_count() const noexcept {
     return leaf_nodes_count;
 }
 
-Route VirtualSwitch::route(DeviceId global_src, DeviceId global_dest) const noexcept {
+Route VirtualSwitch::compute_route(DeviceId global_src, DeviceId global_dest) const noexcept {
 
     assert(0); // should not reach here
     return Route();
@@ -0,0 +1,308 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/Collective.h"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// sends each NPU waits for, per each NPU
+using Dependencies = std::vector<std::vector<int>>;
+
+/**
+ * Divide a size into parts, rounding up so that no send is empty.
+ *
+ * @param size size to divide
+ * @param parts_count number of parts
+ * @return size of a part
+ */
+ChunkSize divide(const ChunkSize size, const uint64_t parts_count) noexcept {
+    assert(parts_count > 0);
+
+    return std::max<ChunkSize>((size + parts_count - 1) / parts_count, 1);
+}
+
+/**
+ * Schedule steps where every NPU sends to the NPU the next step (i.e., exchanges or ring shifts).
+ * The send of an NPU at each step waits for what the NPU received at the previous step.
+ *
+ * @param dag schedule to add the sends to
+ * @param npus_count number of NPUs
+ * @param peers peer NPU of each NPU, per each step
+ * @param sizes size of a send, per each step
+ * @param ready sends each NPU waits for before its first step
+ * @return sends received by each NPU at the last step
+ */
+Dependencies schedule_steps(CollectiveDag& dag,
+                            const int npus_count,
+                            const std::vector<std::vector<DeviceId>>& peers,
+                            const std::vector<ChunkSize>& sizes,
+                            Dependencies ready) noexcept {
+    assert(peers.size() == sizes.size());
+
+    for (size_t step = 0; step < peers.size(); step++) {
+        auto received = Dependencies(npus_count);
+        for (auto npu = 0; npu < npus_count; npu++) {
+            const auto peer = peers[step][npu];
+            received[peer].push_back(dag.add_send(npu, peer, sizes[step], ready[npu]));
+        }
+        ready = std::move(received);
+    }
+
+    return ready;
+}
+
+/**
+ * Schedule a ring pass, every NPU sending to the next one for npus_count - 1 steps.
+ *
+ * @param dag schedule to add the sends to
+ * @param npus_count number of NPUs
+ * @param sizes size of a send, per each step
+ * @param ready sends each NPU waits for before its first step
+ * @return sends received by each NPU at the last step
+ */
+Dependencies schedule_ring(CollectiveDag& dag,
+                           const int npus_count,
+                           const std::vector<ChunkSize>& sizes,
+                           Dependencies ready) noexcept {
+    auto peers = std::vector<std::vector<DeviceId>>(sizes.size(), std::vector<DeviceId>(npus_count));
+    for (auto& step_peers : peers) {
+        for (auto npu = 0; npu < npus_count; npu++) {
+            step_peers[npu] = (npu + 1) % npus_count;
+        }
+    }
+
+    return schedule_steps(dag, npus_count, peers, sizes, std::move(ready));
+}
+
+/**
+ * Schedule pairwise exchanges, every NPU exchanging with the NPU at the given distance per each step.
+ *
+ * @param dag schedule to add the sends to
+ * @param npus_count number of NPUs, a power of 2
+ * @param distances distance (XOR) to the peer, per each step
+ * @param sizes size of a send, per each step
+ * @param ready sends each NPU waits for before its first step
+ * @return sends received by each NPU at the last step
+ */
+Dependencies schedule_exchanges(CollectiveDag& dag,
+                                const int npus_count,
+                                const std::vector<int>& distances,
+                                const std::vector<ChunkSize>& sizes,
+                                Dependencies ready) noexcept {
+    auto peers = std::vector<std::vector<DeviceId>>(distances.size(), std::vector<DeviceId>(npus_count));
+    for (size_t step = 0; step < distances.size(); step++) {
+        for (auto npu = 0; npu < npus_count; npu++) {
+            peers[step][npu] = npu ^ distances[step];
+        }
+    }
+
+    return schedule_steps(dag, npus_count, peers, sizes, std::move(ready));
+}
+
+/**
+ * Schedule every NPU sending to every other NPU at once.
+ *
+ * @param dag schedule to add the sends to
+ * @param npus_count number of NPUs
+ * @param size size of a send
+ * @param ready sends each NPU waits for before sending
+ * @return sends received by each NPU
+ */
+Dependencies schedule_direct(CollectiveDag& dag,
+                             const int npus_count,
+                             const ChunkSize size,
+                             const Dependencies& ready) noexcept {
+    auto received = Dependencies(npus_count);
+    for (auto src = 0; src < npus_count; src++) {
+        for (auto dest = 0; dest < npus_count; dest++) {
+            if (src != dest) {
+                received[dest].push_back(dag.add_send(src, dest, size, ready[src]));
+            }
+        }
+    }
+    return received;
+}
+
+/**
+ * Schedule a pass up the binary tree rooted at NPU 0 (NPU i is the parent of NPUs 2i + 1 and 2i + 2),
+ * then down the tree. Each NPU sends up once its children have sent up,
+ * and sends down once it has received from its parent.
+ *
+ * @param dag schedule to add the sends to
+ * @param npus_count number of NPUs
+ * @param up_size size an NPU sends up, given the size of its subtree
+ * @param down_size size an NPU receives from its parent, given the size of its subtree
+ * @param ready sends each NPU waits for before sending up
+ * @return sends received by each NPU
+ */
+template <typename UpSize, typename DownSize>
+Dependencies schedule_tree(CollectiveDag& dag,
+                           const int npus_count,
+                           const UpSize& up_size,
+                           const DownSize& down_size,
+                           Dependencies ready) noexcept {
+    // size of the subtree of each NPU
+    auto subtree_sizes = std::vector<int>(npus_count, 1);
+    for (auto npu = npus_count - 1; npu > 0; npu--) {
+        subtree_sizes[(npu - 1) / 2] += subtree_sizes[npu];
+    }
+
+    // up the tree, children (of larger ids) first
+    for (auto npu = npus_count - 1; npu > 0; npu--) {
+        const auto parent = (npu - 1) / 2;
+        ready[parent].push_back(dag.add_send(npu, parent, up_size(subtree_sizes[npu]), ready[npu]));
+    }
+
+    // down the tree, parents (of smaller ids) first
+    auto received = Dependencies(npus_count);
+    received[0] = ready[0];
+    for (auto npu = 0; npu < npus_count; npu++) {
+        for (const auto child : {2 * npu + 1, 2 * npu + 2}) {
+            if (child < npus_count) {
+                // the root has received everything on the way up
+                auto dependencies = ready[npu];
+                if (npu > 0) {
+                    dependencies.insert(dependencies.end(), received[npu].begin(), received[npu].end());
+                }
+                received[child] = {dag.add_send(npu, child, down_size(subtree_sizes[child]), dependencies)};
+            }
+        }
+    }
+
+    return received;
+}
+
+/**
+ * Schedule a collective on a slice of the buffers.
+ *
+ * @param dag schedule to add the sends to
+ * @param type collective pattern
+ * @param algorithm algorithm implementing the collective
+ * @param npus_count number of NPUs
+ * @param size size of the slice of each NPU
+ * @param ready sends each NPU waits for before starting
+ * @return sends received by each NPU
+ */
+Dependencies schedule_collective(CollectiveDag& dag,
+                                 const CollectiveType type,
+                                 const CollectiveAlgorithm algorithm,
+                                 const int npus_count,
+                                 const ChunkSize size,
+                                 Dependencies ready) noexcept {
+    const auto n = static_cast<uint64_t>(npus_count);
+    const auto piece = divide(size, n);
+
+    // all-reduce is a reduce-scatter followed by an all-gather, except on trees
+    if (type == CollectiveType::AllReduce && algorithm != CollectiveAlgorithm::Tree) {
+        auto reduced = schedule_collective(dag, CollectiveType::ReduceScatter, algorithm, npus_count, size, ready);
+        return schedule_collective(dag, CollectiveType::AllGather, algorithm, npus_count, size, std::move(reduced));
+    }
+
+    switch (algorithm) {
+    case CollectiveAlgorithm::Ring: {
+        // a piece per step, or the pieces not delivered yet for all-to-all
+        auto sizes = std::vector<ChunkSize>(npus_count - 1, piece);
+        if (type == CollectiveType::AllToAll) {
+            for (auto step = 0; step < npus_count - 1; step++) {
+                sizes[step] = piece * (npus_count - 1 - step);
+            }
+        }
+        return schedule_ring(dag, npus_count, sizes, std::move(ready));
+    }
+
+    case CollectiveAlgorithm::HalvingDoubling: {
+        auto distances = std::vector<int>();
+        auto sizes = std::vector<ChunkSize>();
+        auto halved_size = size;
+        for (auto distance = 1; distance < npus_count; distance *= 2) {
+            if (type == CollectiveType::ReduceScatter) {
+                // halving: the farthest peer first, exchanging half of what's left
+                distances.insert(distances.begin(), distance);
+                halved_size = divide(halved_size, 2);
+                sizes.push_back(halved_size);
+            } else if (type == CollectiveType::AllGather) {
+                // doubling: the nearest peer first, exchanging all gathered so far
+                distances.push_back(distance);
+                sizes.push_back(piece * distance);
+            } else {
+                // all-to-all: half of the buffer per exchange
+                distances.push_back(distance);
+                sizes.push_back(divide(size, 2));
+            }
+        }
+        return schedule_exchanges(dag, npus_count, distances, sizes, std::move(ready));
+    }
+
+    case CollectiveAlgorithm::Direct:
+        return schedule_direct(dag, npus_count, piece, ready);
+
+    case CollectiveAlgorithm::Tree: {
+        const auto whole = [size](int) noexcept { return size; };
+        const auto subtree = [piece](const int subtree_size) noexcept { return piece * subtree_size; };
+        const auto outside = [piece, npus_count](const int subtree_size) noexcept {
+            return piece * (npus_count - subtree_size);
+        };
+        const auto crossing = [piece, npus_count](const int subtree_size) noexcept {
+            return piece * subtree_size * (npus_count - subtree_size);
+        };
+
+        switch (type) {
+        case CollectiveType::AllReduce:
+            // reduce up, broadcast down
+            return schedule_tree(dag, npus_count, whole, whole, std::move(ready));
+        case CollectiveType::AllGather:
+            // gather up, broadcast what's gathered outside of each subtree down
+            return schedule_tree(dag, npus_count, subtree, outside, std::move(ready));
+        case CollectiveType::ReduceScatter:
+            // reduce up, scatter the pieces of each subtree down
+            return schedule_tree(dag, npus_count, whole, subtree, std::move(ready));
+        case CollectiveType::AllToAll:
+            // pieces leaving each subtree go up, pieces entering each subtree come down
+            return schedule_tree(dag, npus_count, crossing, crossing, std::move(ready));
+        }
+    }
+    }
+
+    // unreachable
+    assert(false);
+    return ready;
+}
+
+}  // namespace
+
+std::unique_ptr<CollectiveDag> NetworkAnalyticalCongestionAware::construct_collective(const CollectiveType type,
+                                                                                      const CollectiveAlgorithm algorithm,
+                                                                                      const int npus_count,
+                                                                                      const ChunkSize size,
+                                                                                      const int chunks_count) noexcept {
+    assert(npus_count > 0);
+    assert(size > 0);
+    assert(chunks_count > 0);
+
+    if (algorithm == CollectiveAlgorithm::HalvingDoubling && (npus_count & (npus_count - 1)) != 0) {
+        std::cerr << "[Error] (network/analytical/congestion_aware) "
+                  << "halving-doubling requires a power-of-2 NPUs count, not " << npus_count << std::endl;
+        std::exit(-1);
+    }
+
+    auto dag = std::make_unique<CollectiveDag>();
+    if (npus_count == 1) {
+        return dag;
+    }
+
+    // slices pipeline independently
+    const auto slice_size = divide(size, chunks_count);
+    for (auto slice = 0; slice < chunks_count; slice++) {
+        (void)schedule_collective(*dag, type, algorithm, npus_count, slice_size, Dependencies(npus_count));
+    }
+
+    return dag;
+}
@@ -0,0 +1,143 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/CollectiveDag.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/ChunkPool.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+CollectiveDag::CollectiveDag() noexcept
+    : topology(nullptr),
+      callback(nullptr),
+      callback_arg(nullptr),
+      arrived_sends_count(0),
+      finish_time(0) {}
+
+int CollectiveDag::add_send(const DeviceId src,
+                            const DeviceId dest,
+                            const ChunkSize size,
+                            const std::vector<int>& dependencies) noexcept {
+    assert(src != dest);
+    assert(size > 0);
+
+    // sends can't be added while running
+    assert(topology == nullptr || finished());
+
+    const auto index = static_cast<int>(sends.size());
+    for (const auto dependency : dependencies) {
+        assert(0 <= dependency && dependency < index);
+        sends[dependency].dependents.push_back(index);
+    }
+
+    auto send = Send();
+    send.dag = this;
+    send.index = index;
+    send.src = src;
+    send.dest = dest;
+    send.size = size;
+    send.dependencies_count = static_cast<int>(dependencies.size());
+    send.pending_dependencies_count = 0;
+    sends.push_back(std::move(send));
+
+    return index;
+}
+
+int CollectiveDag::get_sends_count() const noexcept {
+    return static_cast<int>(sends.size());
+}
+
+uint64_t CollectiveDag::get_sent_bytes() const noexcept {
+    auto sent_bytes = uint64_t(0);
+    for (const auto& send : sends) {
+        sent_bytes += send.size;
+    }
+    return sent_bytes;
+}
+
+int CollectiveDag::get_depth() const noexcept {
+    // sends are added after their dependencies, hence in a topological order
+    auto depths = std::vector<int>(sends.size(), 1);
+    auto depth = 0;
+    for (const auto& send : sends) {
+        for (const auto dependent : send.dependents) {
+            depths[dependent] = std::max(depths[dependent], depths[send.index] + 1);
+        }
+        depth = std::max(depth, depths[send.index]);
+    }
+    return depth;
+}
+
+void CollectiveDag::run(Topology* const topology, const Callback callback, const CallbackArg callback_arg) noexcept {
+    assert(topology != nullptr);
+    assert(callback != nullptr);
+    assert(this->topology == nullptr || finished());
+
+    this->topology = topology;
+    this->callback = callback;
+    this->callback_arg = callback_arg;
+    arrived_sends_count = 0;
+
+    for (auto& send : sends) {
+        assert(send.src < topology->get_npus_count() && send.dest < topology->get_npus_count());
+        send.pending_dependencies_count = send.dependencies_count;
+    }
+
+    // an empty collective finishes right away
+    if (sends.empty()) {
+        finish_time = topology->get_simulation_context()->get_current_time();
+        (*callback)(callback_arg);
+        return;
+    }
+
+    // issue the sends without dependencies
+    for (auto& send : sends) {
+        if (send.dependencies_count == 0) {
+            issue(send);
+        }
+    }
+}
+
+bool CollectiveDag::finished() const noexcept {
+    return arrived_sends_count == static_cast<int>(sends.size());
+}
+
+EventTime CollectiveDag::get_finish_time() const noexcept {
+    assert(finished());
+
+    return finish_time;
+}
+
+void CollectiveDag::send_arrived(void* const send_ptr) noexcept {
+    assert(send_ptr != nullptr);
+
+    // cast to Send*
+    auto* const send = static_cast<Send*>(send_ptr);
+    auto* const dag = send->dag;
+    dag->arrived_sends_count++;
+
+    // issue the dependents ready
+    for (const auto dependent : send->dependents) {
+        auto& dependent_send = dag->sends[dependent];
+        assert(dependent_send.pending_dependencies_count > 0);
+        if (--dependent_send.pending_dependencies_count == 0) {
+            dag->issue(dependent_send);
+        }
+    }
+
+    if (dag->finished()) {
+        dag->finish_time = dag->topology->get_simulation_context()->get_current_time();
+        (*dag->callback)(dag->callback_arg);
+    }
+}
+
+void CollectiveDag::issue(Send& send) noexcept {
+    auto* const chunk_pool = topology->get_simulation_context()->get_chunk_pool();
+    auto route = topology->route(send.src, send.dest);
+    auto chunk = chunk_pool->create_chunk(send.size, send.index, std::move(route), send_arrived, &send);
+    topology->send(std::move(chunk));
+}
@@ -7,6 +7,7 @@ LICENSE file in the root directory of this source tree.
 #include "common/NetworkParser.h"
 #include "congestion_aware/Chunk.h"
 #include "congestion_aware/Helper.h"
+#include "congestion_aware/SimulationContext.h"
 #include <iostream>
 
 using namespace NetworkAnalytical;
@@ -22,20 +23,22 @@ void chunk_arrived_callback(void* const event_queue_ptr) {
 }
 
 int main() {
-    // Instantiate shared resources
+    // Instantiate simulation resources
     const auto event_queue = std::make_shared<EventQueue>();
-    Topology::set_event_queue(event_queue);
+    const auto context = std::make_shared<SimulationContext>(event_queue);
 
     // Parse network config and create topology
     const auto network_parser = NetworkParser("../input/Ring.yml");
-    const auto topology = construct_topology(network_parser);
+    const auto topology = construct_topology(network_parser, context);
     const auto npus_count = topology->get_npus_count();
     const auto devices_count = topology->get_devices_count();
+    auto* const chunk_pool = context->get_chunk_pool();
 
     // message settings
     const auto chunk_size = 1'048'576;  // 1 MB
 
     // Run All-Gather
+    auto chunk_id = 0;
     for (int i = 0; i < npus_count; i++) {
         for (int j = 0; j < npus_count; j++) {
             if (i == j) {
@@ -45,7 +48,7 @@ int main() {
             // crate a chunk
             auto route = topology->route(i, j);
             auto* event_queue_ptr = static_cast<void*>(event_queue.get());
-            auto chunk = std::make_unique<Chunk>(chunk_size, route, chunk_arrived_callback, event_queue_ptr);
+            auto chunk = chunk_pool->create_chunk(chunk_size, chunk_id++, route, chunk_arrived_callback, event_queue_ptr);
 
             // send a chunk
             topology->send(std::move(chunk));
@@ -62,6 +65,10 @@ int main() {
     std::cout << "Total NPUs Count: " << npus_count << std::endl;
     std::cout << "Total devices Count: " << devices_count << std::endl;
     std::cout << "Simulation finished at time: " << finish_time << " ns" << std::endl;
+    std::cout << "Peak chunks in flight: " << chunk_pool->get_peak_live_chunks_count() << std::endl;
+
+    // Print link telemetry, if enabled
+    topology->dump_link_telemetry(std::cout);
 
     return 0;
 }
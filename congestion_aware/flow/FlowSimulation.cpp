@@ -0,0 +1,264 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/FlowSimulation.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Device.h"
+#include "congestion_aware/Link.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// rate of a flow not limited by any link
+constexpr auto unlimited_rate = std::numeric_limits<double>::infinity();
+
+/// a flow is finished once the untransmitted bytes fall below this fraction of its size
+constexpr auto finish_tolerance = 1e-9;
+
+}  // namespace
+
+FlowSimulation::FlowSimulation(std::shared_ptr<Topology> topology) noexcept
+    : topology(std::move(topology)),
+      context(nullptr),
+      last_update_time(0),
+      rate_updates_count(0) {
+    assert(this->topology != nullptr);
+
+    context = this->topology->get_simulation_context().get();
+    assert(context != nullptr);
+
+    // flows walk the ports of each device along their routes
+    this->topology->build_link_store();
+}
+
+void FlowSimulation::send(std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+
+    // bind the chunk to the simulation, recording the sent time
+    chunk->set_simulation_context(context);
+
+    // walk the route, collecting the links the flow occupies
+    auto flow = Flow();
+    flow.rate_cap = unlimited_rate;
+    auto latency = static_cast<Latency>(0);
+    while (!chunk->arrived_dest()) {
+        auto* const device = chunk->current_device();
+        const auto port = chunk->next_port();
+        assert(port >= 0);
+
+        const auto* const link = device->get_link(port);
+        latency += link->get_latency();
+        if (link->is_non_blocking()) {
+            flow.rate_cap = std::min(flow.rate_cap, link->get_bandwidth_Bpns());
+        } else {
+            flow.links.push_back(get_link_index(link));
+        }
+
+        chunk->mark_arrived_next_device();
+    }
+    flow.latency = static_cast<EventTime>(latency);
+    flow.remaining_bytes = static_cast<double>(chunk->get_size());
+    flow.rate = 0;
+    flow.chunk = std::move(chunk);
+
+    const auto current_time = context->get_current_time();
+
+    // the chunk is already at its dest
+    if (flow.links.empty() && flow.rate_cap == unlimited_rate) {
+        context->schedule_event(current_time + flow.latency, flow_arrived, static_cast<void*>(flow.chunk.release()));
+        return;
+    }
+
+    // flows sent at the same time start together, by a single update
+    starting_flows.push_back(std::move(flow));
+    schedule_update(current_time);
+}
+
+int FlowSimulation::get_active_flows_count() const noexcept {
+    return static_cast<int>(active_flows.size());
+}
+
+uint64_t FlowSimulation::get_rate_updates_count() const noexcept {
+    return rate_updates_count;
+}
+
+void FlowSimulation::update(void* const flow_simulation_ptr) noexcept {
+    assert(flow_simulation_ptr != nullptr);
+
+    // cast to FlowSimulation*
+    auto* const flow_simulation = static_cast<FlowSimulation*>(flow_simulation_ptr);
+    flow_simulation->process_update();
+}
+
+void FlowSimulation::flow_arrived(void* const chunk_ptr) noexcept {
+    assert(chunk_ptr != nullptr);
+
+    // cast to unique_ptr<Chunk>, destroyed after the callback
+    auto chunk = std::unique_ptr<Chunk>(static_cast<Chunk*>(chunk_ptr));
+    chunk->invoke_callback();
+}
+
+void FlowSimulation::process_update() noexcept {
+    const auto current_time = context->get_current_time();
+    scheduled_updates.erase(current_time);
+
+    // account the progress since the last update
+    const auto elapsed_time = static_cast<double>(current_time - last_update_time);
+    last_update_time = current_time;
+
+    // finish completed flows, which arrive at their dests after propagating through their routes
+    auto flows_changed = !starting_flows.empty();
+    for (size_t i = 0; i < active_flows.size();) {
+        auto& flow = active_flows[i];
+        flow.remaining_bytes -= flow.rate * elapsed_time;
+        if (flow.remaining_bytes > finish_tolerance * static_cast<double>(flow.chunk->get_size())) {
+            i++;
+            continue;
+        }
+
+        const auto arrival_time = current_time + flow.latency;
+        context->schedule_event(arrival_time, flow_arrived, static_cast<void*>(flow.chunk.release()));
+        if (i + 1 < active_flows.size()) {
+            flow = std::move(active_flows.back());
+        }
+        active_flows.pop_back();
+        flows_changed = true;
+    }
+
+    // start new flows
+    for (auto& flow : starting_flows) {
+        active_flows.push_back(std::move(flow));
+    }
+    starting_flows.clear();
+
+    if (active_flows.empty()) {
+        return;
+    }
+
+    // rates only change when flows start or finish
+    if (flows_changed) {
+        compute_rates();
+    }
+
+    // wake up once the earliest flow finishes
+    auto next_update_time = std::numeric_limits<EventTime>::max();
+    for (const auto& flow : active_flows) {
+        assert(flow.rate > 0);
+        const auto remaining_time = static_cast<EventTime>(std::ceil(flow.remaining_bytes / flow.rate));
+        next_update_time = std::min(next_update_time, current_time + std::max<EventTime>(remaining_time, 1));
+    }
+    schedule_update(next_update_time);
+}
+
+void FlowSimulation::schedule_update(const EventTime update_time) noexcept {
+    // updates scheduled earlier are kept, they're harmless if nothing changes by then
+    if (scheduled_updates.insert(update_time).second) {
+        context->schedule_event(update_time, update, static_cast<void*>(this));
+    }
+}
+
+void FlowSimulation::compute_rates() noexcept {
+    rate_updates_count++;
+
+    const auto links_count = link_capacities.size();
+    const auto flows_count = active_flows.size();
+
+    // flows crossing each link, and the links crossed by any flow
+    auto link_flows = std::vector<std::vector<int>>(links_count);
+    auto used_links = std::vector<int>();
+    for (size_t i = 0; i < flows_count; i++) {
+        for (const auto link : active_flows[i].links) {
+            if (link_flows[link].empty()) {
+                used_links.push_back(link);
+            }
+            link_flows[link].push_back(static_cast<int>(i));
+        }
+    }
+
+    // capacity left, and the number of flows not assigned a rate yet, per each link
+    auto residual_capacities = link_capacities;
+    auto unfrozen_flows_counts = std::vector<int>(links_count, 0);
+    for (const auto link : used_links) {
+        unfrozen_flows_counts[link] = static_cast<int>(link_flows[link].size());
+    }
+
+    // flows capped by non-blocking links, in the increasing order of their caps
+    auto capped_flows = std::vector<int>();
+    for (size_t i = 0; i < flows_count; i++) {
+        active_flows[i].rate = -1;
+        if (active_flows[i].rate_cap != unlimited_rate) {
+            capped_flows.push_back(static_cast<int>(i));
+        }
+    }
+    std::sort(capped_flows.begin(), capped_flows.end(), [this](const int lhs, const int rhs) noexcept {
+        return active_flows[lhs].rate_cap < active_flows[rhs].rate_cap;
+    });
+    auto next_capped_flow = size_t(0);
+
+    // assign the rate to a flow, taking the capacity of its links
+    auto unfrozen_flows_count = flows_count;
+    const auto freeze = [&](Flow& flow, const double rate) noexcept {
+        assert(flow.rate < 0);
+        flow.rate = rate;
+        for (const auto link : flow.links) {
+            residual_capacities[link] -= rate;
+            unfrozen_flows_counts[link]--;
+        }
+        unfrozen_flows_count--;
+    };
+
+    // progressive filling: repeatedly saturate the bottleneck with the smallest fair share
+    while (unfrozen_flows_count > 0) {
+        auto fair_share = unlimited_rate;
+        auto bottleneck = -1;
+        for (const auto link : used_links) {
+            if (unfrozen_flows_counts[link] > 0) {
+                const auto share = std::max(residual_capacities[link], 0.0) / unfrozen_flows_counts[link];
+                if (share < fair_share) {
+                    fair_share = share;
+                    bottleneck = link;
+                }
+            }
+        }
+
+        while (next_capped_flow < capped_flows.size() && active_flows[capped_flows[next_capped_flow]].rate >= 0) {
+            next_capped_flow++;
+        }
+        if (next_capped_flow < capped_flows.size()) {
+            auto& capped_flow = active_flows[capped_flows[next_capped_flow]];
+            if (capped_flow.rate_cap <= fair_share) {
+                freeze(capped_flow, capped_flow.rate_cap);
+                continue;
+            }
+        }
+
+        assert(bottleneck >= 0);
+        for (const auto i : link_flows[bottleneck]) {
+            if (active_flows[i].rate < 0) {
+                freeze(active_flows[i], fair_share);
+            }
+        }
+    }
+}
+
+int FlowSimulation::get_link_index(const Link* const link) noexcept {
+    assert(link != nullptr);
+
+    const auto link_index = link_indices.find(link);
+    if (link_index != link_indices.end()) {
+        return link_index->second;
+    }
+
+    // register the link
+    const auto index = static_cast<int>(link_capacities.size());
+    link_indices[link] = index;
+    link_capacities.push_back(link->get_bandwidth_Bpns());
+    return index;
+}
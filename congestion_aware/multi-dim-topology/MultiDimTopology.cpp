@@ -12,165 +12,315 @@ LICENSE file in the root directory of this source tree.
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
 
-MultiDimTopology::MultiDimTopology() noexcept : Topology(0) {
+namespace {
+
+/**
+ * Check if a building block is a level of a switch hierarchy (i.e., has no NPUs of its own).
+ *
+ * @param topology building block
+ * @return true if VirtualSwitch or SpinalSwitch, false otherwise
+ */
+bool is_switch_hierarchy(const BasicTopology& topology) noexcept {
+    const auto type = topology.get_basic_topology_type();
+    return type == TopologyBuildingBlock::VirtualSwitch || type == TopologyBuildingBlock::SpinalSwitch;
+}
+
+/**
+ * Get the size of the dimension a building block spans.
+ *
+ * @param topology building block
+ * @return number of NPUs, or leaf nodes of VirtualSwitch and SpinalSwitch
+ */
+int get_dim_size(const BasicTopology& topology) noexcept {
+    switch (topology.get_basic_topology_type()) {
+    case TopologyBuildingBlock::VirtualSwitch:
+        return static_cast<const VirtualSwitch&>(topology).get_leaf_nodes_count();
+    case TopologyBuildingBlock::SpinalSwitch:
+        // leaf switches, followed by the spinal switch
+        return topology.get_devices_count() - 1;
+    default:
+        return topology.get_npus_count();
+    }
+}
+
+}  // namespace
+
+MultiDimTopology::MultiDimTopology(std::shared_ptr<SimulationContext> context) noexcept
+    : Topology(0, std::move(context)) {
     // initialize values
     topology_per_dim.clear();
     npus_count_per_dim = {};
 
     // initialize topology shape
-    npus_count = 0;
+    npus_count = 1;
     devices_count = 0;
     dims_count = 0;
-    real_swtich_count = 0;
 }
 
-void MultiDimTopology::append_dimension(std::vector<std::unique_ptr<BasicTopology>> topologies) noexcept {
-    // increment dims_count
+void MultiDimTopology::append_dimension(std::unique_ptr<BasicTopology> topology) noexcept {
+    assert(topology != nullptr);
+
+    // devices are instantiated once every dimension is appended
+    assert(devices.empty());
+
+    // NPUs adjacent along the dimension are apart by the number of NPUs of the dimensions below
+    const auto dim_size = get_dim_size(*topology);
+    assert(dim_size > 0);
+    stride_per_dim.push_back(npus_count);
+
+    // increment dims_count and npus_count
     dims_count++;
+    npus_count *= dim_size;
 
-    // increase npus_count and devices_count
-    auto npus_size = topologies[0]->get_npus_count();
-    auto devices_size = topologies[0]->get_devices_count();
-    npus_count += npus_size*topologies.size();
-    devices_count += devices_size*topologies.size();
+    // push back topology, npus_count, and bandwidth
+    npus_count_per_dim.push_back(dim_size);
+    bandwidth_per_dim.push_back(topology->get_bandwidth());
+    topology_per_dim.push_back(std::move(topology));
+}
 
-    // append bandwidth
-    const auto bandwidth = topologies[0]->get_bandwidth_per_dim()[0];
-    bandwidth_per_dim.push_back(bandwidth);
+void MultiDimTopology::connect_dimensions() noexcept {
+    assert(dims_count > 0);
+    assert(devices.empty());
 
-    // append devices
-    for (auto& topology : topologies) {
-        auto topology_devices = topology->get_devices();
-        devices.insert(devices.end(), topology_devices.begin(), topology_devices.end());
+    // switches of each dimension are laid out after the NPUs
+    devices_count = npus_count;
+    for (auto dim = 0; dim < dims_count; dim++) {
+        const auto& topology = topology_per_dim[dim];
+        switches_count_per_dim.push_back(topology->get_devices_count() - topology->get_npus_count());
+        switch_base_id_per_dim.push_back(devices_count);
+        devices_count += switches_count_per_dim[dim] * get_replicas_count(dim);
     }
-    
-    // push back topology and npus_count
-    topology_per_dim.push_back(std::move(topologies));
-    if (npus_size == 0 || devices_size == 0) {
-        npus_count_per_dim.push_back(1);
+    instantiate_devices();
+
+    // VirtualSwitch dimensions are reached through the leaf switches of the closest SpinalSwitch dimension above
+    leaf_dim_per_dim.assign(dims_count, -1);
+    for (auto dim = dims_count - 1; dim >= 0; dim--) {
+        if (topology_per_dim[dim]->get_basic_topology_type() != TopologyBuildingBlock::VirtualSwitch) {
+            continue;
+        }
+        const auto next_dim = dim + 1;
+        if (next_dim == dims_count || !is_switch_hierarchy(*topology_per_dim[next_dim])) {
+            std::cerr << "[Error] (network/analytical/congestion_aware) "
+                      << "VirtualSwitch dimension " << dim << " should be followed by a VirtualSwitch or SpinalSwitch"
+                      << std::endl;
+            std::exit(-1);
+        }
+        const auto next_type = topology_per_dim[next_dim]->get_basic_topology_type();
+        leaf_dim_per_dim[dim] = (next_type == TopologyBuildingBlock::SpinalSwitch) ? next_dim : leaf_dim_per_dim[next_dim];
     }
-    else {
-        npus_count_per_dim.push_back(2*8*48);
+
+    for (auto dim = 0; dim < dims_count; dim++) {
+        const auto& topology = topology_per_dim[dim];
+        const auto local_devices = topology->get_devices();
+
+        // replicate the links of the building block
+        for (auto replica_index = 0; replica_index < get_replicas_count(dim); replica_index++) {
+            const auto replica_base_id = get_replica_base_id(replica_index, dim);
+            const auto translate_id = [this, dim, replica_index, replica_base_id](const DeviceId local_id) noexcept {
+                return translate_local_id(local_id, dim, replica_index, replica_base_id);
+            };
+            for (const auto& local_device : local_devices) {
+                devices[translate_id(local_device->get_id())]->connect_as(*local_device, translate_id);
+            }
+        }
+
+        // connect every NPU to the leaf switch above it,
+        // with the links of the VirtualSwitch dimension below if any
+        if (topology->get_basic_topology_type() == TopologyBuildingBlock::SpinalSwitch) {
+            const auto& link_topology = (dim > 0 && leaf_dim_per_dim[dim - 1] == dim) ? topology_per_dim[dim - 1]
+                                                                                       : topology;
+            const auto bandwidth = link_topology->get_bandwidth();
+            const auto latency = link_topology->get_latency();
+            for (auto npu_id = 0; npu_id < npus_count; npu_id++) {
+                const auto leaf_switch_id = translate_local_id(get_address(npu_id, dim), dim,
+                                                               get_replica_index(npu_id, dim), 0);
+                devices[npu_id]->connect(leaf_switch_id, bandwidth, latency, false);
+                devices[leaf_switch_id]->connect(npu_id, bandwidth, latency, false);
+            }
+        }
+
+        // routes within the building block are looked up in constant time
+        build_local_route_table(dim);
     }
 }
 
-MultiDimTopology::MultiDimAddress MultiDimTopology::translate_address(const DeviceId npu_id) const noexcept {
-    // If units-count if [2, 8, 4], and the given id is 47, then the id should be
-    // 47 // 16 = 2, leftover = 47 % 16 = 15
-    // 15 // 2 = 7, leftover = 15 % 2 = 1
-    // 1 // 1 = 1, leftover = 0
-    // therefore the address is [1, 7, 2]
+Route MultiDimTopology::compute_route(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(src != dest);
 
-    // create empty address
-    auto multi_dim_address = MultiDimAddress();
+    auto route = Route();
+    route.push_back(devices[src].get());
 
-    auto leaf_nodes_count = this->leaf_nodes_count;
-    auto SpinalSwitchIndex = npu_id / (2*leaf_nodes_count);
-    auto LeafGroupIndex = (npu_id / 2) % leaf_nodes_count;
-    auto MeshGroupIndex = npu_id % 2;
+    // move along each dimension where the addresses differ, from the last dimension to the first
+    auto current_id = src;
+    for (auto dim = dims_count - 1; dim >= 0; dim--) {
+        if (get_address(current_id, dim) == get_address(dest, dim)) {
+            continue;
+        }
 
-    multi_dim_address.push_back(MeshGroupIndex);
-    multi_dim_address.push_back(LeafGroupIndex);
-    multi_dim_address.push_back(SpinalSwitchIndex);
+        switch (topology_per_dim[dim]->get_basic_topology_type()) {
+        case TopologyBuildingBlock::SpinalSwitch: {
+            // leaf switch -> spinal switch -> leaf switch, reaching the address of dest below as well
+            const auto next_id = replace_lower_addresses(current_id, dest, dim);
+            append_route_in_dim(route, current_id, next_id, dim);
+            current_id = next_id;
+            break;
+        }
+        case TopologyBuildingBlock::VirtualSwitch: {
+            // through the leaf switch shared by the NPUs, reaching the address of dest below as well
+            const auto leaf_dim = leaf_dim_per_dim[dim];
+            const auto next_id = replace_lower_addresses(current_id, dest, dim);
+            const auto leaf_switch_id = translate_local_id(get_address(current_id, leaf_dim), leaf_dim,
+                                                           get_replica_index(current_id, leaf_dim), 0);
+            assert(leaf_switch_id == translate_local_id(get_address(next_id, leaf_dim), leaf_dim,
+                                                        get_replica_index(next_id, leaf_dim), 0));
+            route.push_back(devices[leaf_switch_id].get());
+            route.push_back(devices[next_id].get());
+            current_id = next_id;
+            break;
+        }
+        default: {
+            // within the replica of the building block
+            const auto address_difference = get_address(dest, dim) - get_address(current_id, dim);
+            const auto next_id = current_id + address_difference * stride_per_dim[dim];
+            append_route_in_dim(route, current_id, next_id, dim);
+            current_id = next_id;
+            break;
+        }
+        }
+    }
 
-    // return retrieved address
-    return multi_dim_address;
+    assert(current_id == dest);
+    return route;
 }
 
-int MultiDimTopology::get_dim_to_transfer(const MultiDimAddress& src_address,
-                                          const MultiDimAddress& dest_address) const noexcept {
-    for (auto dim = dims_count -1 ; dim >= 0; dim--) {
-        // check the dim that has different address
-        if (src_address[dim] != dest_address[dim]) {
-            return dim;
-        }
+int MultiDimTopology::get_address(const DeviceId npu_id, const int dim) const noexcept {
+    assert(0 <= npu_id && npu_id < npus_count);
+    assert(0 <= dim && dim < dims_count);
+
+    return (npu_id / stride_per_dim[dim]) % npus_count_per_dim[dim];
+}
+
+DeviceId MultiDimTopology::replace_lower_addresses(const DeviceId src,
+                                                   const DeviceId dest,
+                                                   const int dim) const noexcept {
+    // NPUs below each address of the dimension span a contiguous range
+    const auto span = stride_per_dim[dim] * npus_count_per_dim[dim];
+    return src - (src % span) + (dest % span);
+}
+
+int MultiDimTopology::get_replica_index(const DeviceId npu_id, const int dim) const noexcept {
+    const auto stride = stride_per_dim[dim];
+    const auto span = stride * npus_count_per_dim[dim];
+
+    // a replica of VirtualSwitch or SpinalSwitch holds every NPU below it
+    if (is_switch_hierarchy(*topology_per_dim[dim])) {
+        return npu_id / span;
     }
 
-    // shouldn't reach here
-    std::cerr << "[Error] (network/analytical/congestion_unaware): " << "src and dest have the same address"
-              << std::endl;
-    std::exit(-1);
+    // NPUs are of the same replica if their addresses differ in the dimension only
+    return (npu_id % stride) + (npu_id / span) * stride;
 }
 
+DeviceId MultiDimTopology::get_replica_base_id(const int replica_index, const int dim) const noexcept {
+    const auto stride = stride_per_dim[dim];
+    const auto span = stride * npus_count_per_dim[dim];
 
-void MultiDimTopology::connect_dimensions(const int dim1, const int dim2) noexcept {
-    // Connection
-    auto& current_topologies = topology_per_dim[dim1];
-    auto& next_topologies = topology_per_dim[dim2];
+    if (is_switch_hierarchy(*topology_per_dim[dim])) {
+        return replica_index * span;
+    }
 
-    auto& current_topology = current_topologies[0];
-    auto& next_topology = next_topologies[0];
+    return (replica_index % stride) + (replica_index / stride) * span;
+}
 
-    if (current_topology->get_basic_topology_type() == NetworkAnalytical::TopologyBuildingBlock::VirtualSwitch) {
-        // Skip virtual switch
-        return;
+int MultiDimTopology::get_replicas_count(const int dim) const noexcept {
+    if (is_switch_hierarchy(*topology_per_dim[dim])) {
+        return npus_count / (stride_per_dim[dim] * npus_count_per_dim[dim]);
     }
 
-    assert(next_topology->get_basic_topology_type() == NetworkAnalytical::TopologyBuildingBlock::VirtualSwitch);
-    
-    auto virtual_bandwidth = next_topology->get_bandwidth();
-    auto virtual_latency = next_topology->get_latency();
-    auto* virtual_switch = static_cast<VirtualSwitch*>(next_topology.get());
-    auto leaf_nodes_count = virtual_switch->get_leaf_nodes_count();
-    this->leaf_nodes_count = leaf_nodes_count;
-
-    auto& spinal_switch_topology = topology_per_dim[dim2+1][0];
-    auto spinal_switches = spinal_switch_topology->get_devices();
-
-    auto spinal_switch_index = 0;
-    auto leaf_node_index = 0;
-    for (auto& cur_topo : current_topologies) {
-        // connect npu devices to switches
-        auto cur_devices = cur_topo->get_devices();
-        for (auto& cur_device : cur_devices) {
-            cur_device->connect(spinal_switches[spinal_switch_index]->get_id(), virtual_bandwidth, virtual_latency, false);
-            spinal_switches[spinal_switch_index]->connect(cur_device->get_id(), virtual_bandwidth, virtual_latency, false);
-            device_2_father_device_map[cur_device->get_id()] = spinal_switches[spinal_switch_index]->get_id();
-            leaf_node_index++;
-            if (leaf_node_index == 2*leaf_nodes_count) {
-                leaf_node_index = 0;
-                spinal_switch_index++;
-            }
-        }
+    return npus_count / npus_count_per_dim[dim];
+}
+
+DeviceId MultiDimTopology::translate_local_id(const DeviceId local_id,
+                                              const int dim,
+                                              const int replica_index,
+                                              const DeviceId replica_base_id) const noexcept {
+    const auto local_npus_count = topology_per_dim[dim]->get_npus_count();
+
+    // NPUs of the replica are apart by the stride
+    if (local_id < local_npus_count) {
+        return replica_base_id + local_id * stride_per_dim[dim];
     }
 
-    return;
+    // switches of the replica are contiguous
+    return switch_base_id_per_dim[dim] + replica_index * switches_count_per_dim[dim] + (local_id - local_npus_count);
 }
 
-Route MultiDimTopology::route(DeviceId src, DeviceId dest) const noexcept {
-    Route route;
-
-    auto src_multi_dim_address = translate_address(src);
-    auto dest_multi_dim_address = translate_address(dest);
-    auto dim_to_transfer = get_dim_to_transfer(src_multi_dim_address, dest_multi_dim_address);
-    
-    
-    if (dim_to_transfer == 0) {
-        //  Located in the same dimension
-        for (auto& topology : topology_per_dim[dim_to_transfer]) {
-            if (topology->contains_device(src) && topology->contains_device(dest)) {
-                route = topology->route(src, dest);
-                break;
-            }
-        }
-    }else{
-        auto src_father_device_id = device_2_father_device_map.at(src);
-        auto dest_father_device_id = device_2_father_device_map.at(dest);
-        if (src_father_device_id == dest_father_device_id) {
-            route.push_back(get_device(src));
-            route.push_back(get_device(src_father_device_id));
-            route.push_back(get_device(dest));
-        }
-        else {
-            route.push_back(get_device(src));
-            route.push_back(get_device(src_father_device_id));
-            route.push_back(get_device(real_swtich_count+npu_counts));
-            route.push_back(get_device(dest_father_device_id));
-            route.push_back(get_device(dest));        
+void MultiDimTopology::append_route_in_dim(Route& route,
+                                           const DeviceId src,
+                                           const DeviceId dest,
+                                           const int dim) const noexcept {
+    const auto& topology = topology_per_dim[dim];
+    const auto replica_index = get_replica_index(src, dim);
+    const auto replica_base_id = get_replica_base_id(replica_index, dim);
+    assert(replica_index == get_replica_index(dest, dim));
+
+    if (topology->get_basic_topology_type() == TopologyBuildingBlock::SpinalSwitch) {
+        // src -> leaf switch -> spinal switch -> leaf switch -> dest
+        const auto spinal_switch_id = translate_local_id(npus_count_per_dim[dim], dim, replica_index, 0);
+        route.push_back(devices[translate_local_id(get_address(src, dim), dim, replica_index, 0)].get());
+        route.push_back(devices[spinal_switch_id].get());
+        route.push_back(devices[translate_local_id(get_address(dest, dim), dim, replica_index, 0)].get());
+        route.push_back(devices[dest].get());
+        return;
+    }
+
+    const auto local_src = get_address(src, dim);
+    const auto local_dest = get_address(dest, dim);
+
+    // tabulated route of the building block, translated into the replica
+    const auto& local_route_table = local_route_table_per_dim[dim];
+    if (!local_route_table.offsets.empty()) {
+        const auto pair = local_src * npus_count_per_dim[dim] + local_dest;
+        for (auto i = local_route_table.offsets[pair]; i < local_route_table.offsets[pair + 1]; i++) {
+            const auto device_id =
+                translate_local_id(local_route_table.route_devices[i], dim, replica_index, replica_base_id);
+            route.push_back(devices[device_id].get());
         }
+        return;
     }
 
-    return route;
+    // route of the building block computed on the fly (no route cache, so safe to compute concurrently),
+    // translated into the replica (src is already in the route)
+    const auto local_route = topology->route(local_src, local_dest);
+    for (auto it = local_route.begin() + 1; it != local_route.end(); ++it) {
+        const auto device_id = translate_local_id((*it)->get_id(), dim, replica_index, replica_base_id);
+        route.push_back(devices[device_id].get());
+    }
 }
 
+void MultiDimTopology::build_local_route_table(const int dim) noexcept {
+    const auto& topology = topology_per_dim[dim];
+    const auto dim_size = npus_count_per_dim[dim];
+    local_route_table_per_dim.resize(dims_count);
 
+    // switch hierarchies are routed by the multi-dim topology itself, and large building blocks on the fly
+    if (is_switch_hierarchy(*topology) || dim_size > max_local_route_table_npus_count) {
+        return;
+    }
+
+    auto& local_route_table = local_route_table_per_dim[dim];
+    local_route_table.offsets.push_back(0);
+    for (auto local_src = 0; local_src < dim_size; local_src++) {
+        for (auto local_dest = 0; local_dest < dim_size; local_dest++) {
+            if (local_src != local_dest) {
+                const auto local_route = topology->route(local_src, local_dest);
+                for (auto it = local_route.begin() + 1; it != local_route.end(); ++it) {
+                    local_route_table.route_devices.push_back((*it)->get_id());
+                }
+            }
+            local_route_table.offsets.push_back(static_cast<uint32_t>(local_route_table.route_devices.size()));
+        }
+    }
+}
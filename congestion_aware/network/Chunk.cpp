@@ -4,10 +4,10 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_aware/Chunk.h"
+#include "congestion_aware/ChunkPool.h"
 #include "congestion_aware/Device.h"
 #include "congestion_aware/Link.h"
 #include <cassert>
-#include <iostream>
 
 using namespace NetworkAnalyticalCongestionAware;
 
@@ -21,10 +21,14 @@ void Chunk::chunk_arrived_next_device(void* const chunk_ptr) noexcept {
     // mark chunk arrived next node
     chunk->mark_arrived_next_device();
 
+    // the chunk is now handled by the simulation of its current device
+    chunk->context = chunk->current_device()->get_simulation_context();
+
     if (chunk->arrived_dest()) {
         // chunk arrived dest, invoke callback
         // as chunk is unique_ptr, will be destroyed automatically
-        chunk->arrival_time = Link::event_queue->get_current_time();
+        // (and recycled into its ChunkPool, if created by one)
+        chunk->arrival_time = chunk->context->get_current_time();
         chunk->dump_info();
         chunk->invoke_callback();
     } else {
@@ -36,14 +40,17 @@ void Chunk::chunk_arrived_next_device(void* const chunk_ptr) noexcept {
 
 Chunk::Chunk(const ChunkSize chunk_size, int chunk_id, Route route, const Callback callback, const CallbackArg callback_arg) noexcept
     : chunk_size(chunk_size),
+      packet_size(0),
       chunk_id(chunk_id),
+      virtual_channel(0),
       route(std::move(route)),
       callback(callback),
-      callback_arg(callback_arg) {
+      callback_arg(callback_arg),
+      context(nullptr) {
     assert(chunk_size > 0);
     assert(!this->route.empty());
     assert(callback != nullptr);
-    sent_time = Link::event_queue->get_current_time();
+    sent_time = 0;
     arrival_time = 0;
     src_device_id = this->route.front()->get_id();
     dst_device_id = this->route.back()->get_id();
@@ -51,9 +58,29 @@ Chunk::Chunk(const ChunkSize chunk_size, int chunk_id, Route route, const Callba
     stall_times = 0;
     stall_time_begin = 0;
     last_bpns = 1e31;
+    tail_arrival_time = 0;
+}
+
+void* Chunk::operator new(const size_t size) {
+    return ChunkPool::allocate_unpooled(size);
+}
+
+void Chunk::operator delete(void* const chunk_ptr) noexcept {
+    ChunkPool::release(chunk_ptr);
+}
+
+void Chunk::set_simulation_context(SimulationContext* const context) noexcept {
+    assert(context != nullptr);
+
+    // bind the chunk to the simulation, and record the sent time
+    this->context = context;
+    sent_time = context->get_current_time();
+
+    // the entire chunk is ready at its source
+    tail_arrival_time = sent_time;
 }
 
-std::shared_ptr<Device> Chunk::current_device() const noexcept {
+Device* Chunk::current_device() const noexcept {
     // assert the route is not empty
     assert(!route.empty());
 
@@ -61,13 +88,24 @@ std::shared_ptr<Device> Chunk::current_device() const noexcept {
     return route.front();
 }
 
-std::shared_ptr<Device> Chunk::next_device() const noexcept {
+Device* Chunk::next_device() const noexcept {
     // assert the chunk has next dest
     assert(!arrived_dest());
 
     // return next dest
-    const auto next_dest = std::next(route.begin(), 1);
-    return *next_dest;
+    return route.next();
+}
+
+int Chunk::next_port() noexcept {
+    // assert the chunk has next dest
+    assert(!arrived_dest());
+
+    // resolve every hop at once, so that the following hops don't look up the ports
+    if (!route.has_ports()) {
+        route.resolve_ports();
+    }
+
+    return route.next_port();
 }
 
 void Chunk::mark_arrived_next_device() noexcept {
@@ -75,9 +113,14 @@ void Chunk::mark_arrived_next_device() noexcept {
     // it means the chunk hasn't arrived its final dest yet
     assert(!arrived_dest());
 
-    // pop previous node from the route
+    // move the route cursor to the next node
     // marking the current node has been changed
-    route.pop_front();
+    route.advance();
+}
+
+bool Chunk::next_device_is_dest() const noexcept {
+    // if the next device is the dest, route length should be 2
+    return route.size() == 2;
 }
 
 bool Chunk::arrived_dest() const noexcept {
@@ -99,15 +142,50 @@ ChunkSize Chunk::get_size() const noexcept {
     return chunk_size;
 }
 
+void Chunk::set_packet_size(const ChunkSize packet_size) noexcept {
+    this->packet_size = packet_size;
+}
+
+ChunkSize Chunk::get_packet_size() const noexcept {
+    return packet_size;
+}
+
+void Chunk::set_virtual_channel(const int virtual_channel) noexcept {
+    assert(virtual_channel >= 0);
+
+    this->virtual_channel = virtual_channel;
+}
+
+int Chunk::get_virtual_channel() const noexcept {
+    return virtual_channel;
+}
+
 void Chunk::invoke_callback() noexcept {
     // invoke callback
     (*callback)(callback_arg);
 }
 
 void Chunk::dump_info() noexcept {
-    if (eventTrackerFileStream && eventTrackerFileStream.is_open()) {
-        eventTrackerFileStream << src_device_id << " " << dst_device_id << " " 
-        << sent_time << " " << arrival_time << " " << stall_count << " " 
-        << stall_times << " " << chunk_size << std::endl;
+    assert(context != nullptr);
+
+    auto* const chrome_trace_writer = context->get_chrome_trace_writer();
+    if (chrome_trace_writer != nullptr) {
+        chrome_trace_writer->write_chunk(*this, sent_time, arrival_time);
     }
+
+    auto* const trace_writer = context->get_trace_writer();
+    if (trace_writer == nullptr) {
+        return;
+    }
+
+    auto record = TraceRecord();
+    record.src = src_device_id;
+    record.dest = dst_device_id;
+    record.sent_time = sent_time;
+    record.arrival_time = arrival_time;
+    record.stall_count = static_cast<uint32_t>(stall_count);
+    record.reserved = 0;
+    record.stall_time = stall_times;
+    record.chunk_size = chunk_size;
+    trace_writer->write(record);
 }
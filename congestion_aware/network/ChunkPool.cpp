@@ -0,0 +1,109 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/ChunkPool.h"
+#include "congestion_aware/Chunk.h"
+#include <cassert>
+#include <new>
+#include <thread>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+ChunkPool::ChunkPool() noexcept {
+    locked.clear();
+}
+
+std::unique_ptr<Chunk> ChunkPool::create_chunk(const ChunkSize chunk_size,
+                                               const int chunk_id,
+                                               Route route,
+                                               const Callback callback,
+                                               const CallbackArg callback_arg) noexcept {
+    // a chunk should fit in a slab block, or every chunk would silently fall back to the heap
+    static_assert(sizeof(ChunkHeader) + sizeof(Chunk) <= MemoryPool::max_block_size,
+                  "ChunkHeader and Chunk should fit in a MemoryPool block");
+    static_assert(alignof(Chunk) <= alignof(ChunkHeader), "Chunk should be aligned right after ChunkHeader");
+
+    // take a block out of the pool
+    lock();
+    auto* const block = memory_pool.allocate(sizeof(ChunkHeader) + sizeof(Chunk));
+    unlock();
+
+    // record the owner pool, and construct the chunk right after the header
+    auto* const header = new (block) ChunkHeader{this};
+    auto* const chunk_ptr = static_cast<void*>(header + 1);
+    auto* const chunk = ::new (chunk_ptr) Chunk(chunk_size, chunk_id, std::move(route), callback, callback_arg);
+
+    return std::unique_ptr<Chunk>(chunk);
+}
+
+uint64_t ChunkPool::get_created_chunks_count() const noexcept {
+    lock();
+    const auto created_chunks_count = memory_pool.get_allocations_count();
+    unlock();
+
+    return created_chunks_count;
+}
+
+uint64_t ChunkPool::get_live_chunks_count() const noexcept {
+    lock();
+    const auto live_chunks_count = memory_pool.get_live_blocks_count();
+    unlock();
+
+    return live_chunks_count;
+}
+
+uint64_t ChunkPool::get_peak_live_chunks_count() const noexcept {
+    lock();
+    const auto peak_live_chunks_count = memory_pool.get_peak_live_blocks_count();
+    unlock();
+
+    return peak_live_chunks_count;
+}
+
+uint64_t ChunkPool::get_heap_allocations_count() const noexcept {
+    lock();
+    const auto heap_allocations_count = memory_pool.get_heap_allocations_count();
+    unlock();
+
+    return heap_allocations_count;
+}
+
+void* ChunkPool::allocate_unpooled(const size_t size) {
+    // not owned by any pool
+    auto* const block = ::operator new(sizeof(ChunkHeader) + size);
+    auto* const header = new (block) ChunkHeader{nullptr};
+
+    return static_cast<void*>(header + 1);
+}
+
+void ChunkPool::release(void* const chunk_ptr) noexcept {
+    if (chunk_ptr == nullptr) {
+        return;
+    }
+
+    auto* const header = static_cast<ChunkHeader*>(chunk_ptr) - 1;
+    auto* const pool = header->pool;
+
+    // allocated from the heap
+    if (pool == nullptr) {
+        ::operator delete(static_cast<void*>(header));
+        return;
+    }
+
+    // recycle into the owner pool
+    pool->lock();
+    pool->memory_pool.deallocate(static_cast<void*>(header), sizeof(ChunkHeader) + sizeof(Chunk));
+    pool->unlock();
+}
+
+void ChunkPool::lock() const noexcept {
+    while (locked.test_and_set(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+void ChunkPool::unlock() const noexcept {
+    locked.clear(std::memory_order_release);
+}
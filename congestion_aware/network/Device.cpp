@@ -6,13 +6,22 @@ LICENSE file in the root directory of this source tree.
 #include "congestion_aware/Device.h"
 #include "congestion_aware/Chunk.h"
 #include "congestion_aware/Link.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
 using namespace NetworkAnalyticalCongestionAware;
 
-Device::Device(const DeviceId id, const DeviceId group_base_id) noexcept : device_id(id), GroupBaseId(group_base_id) {
+Device::Device(const DeviceId id, std::shared_ptr<SimulationContext> context, const DeviceId group_base_id) noexcept
+    : device_id(id),
+      GroupBaseId(group_base_id),
+      context(std::move(context)),
+      links(nullptr),
+      neighbors(nullptr),
+      ports_count(0),
+      contiguous_neighbors(false) {
     assert(id >= 0);
+    assert(this->context != nullptr);
 }
 
 DeviceId Device::get_id() const noexcept {
@@ -21,6 +30,61 @@ DeviceId Device::get_id() const noexcept {
     return device_id;
 }
 
+SimulationContext* Device::get_simulation_context() const noexcept {
+    return context.get();
+}
+
+void Device::set_simulation_context(std::shared_ptr<SimulationContext> context) noexcept {
+    assert(context != nullptr);
+
+    // move outgoing links together
+    for (auto port = 0; port < ports_count; port++) {
+        links[port].set_simulation_context(context);
+    }
+
+    this->context = std::move(context);
+}
+
+int Device::get_ports_count() const noexcept {
+    assert(links != nullptr || pending_links.empty());
+
+    return ports_count;
+}
+
+DeviceId Device::get_neighbor(const int port) const noexcept {
+    assert(0 <= port && port < ports_count);
+
+    return neighbors[port];
+}
+
+Link* Device::get_link(const int port) const noexcept {
+    assert(0 <= port && port < ports_count);
+
+    return &links[port];
+}
+
+int Device::get_port(const DeviceId dest) const noexcept {
+    assert(dest >= 0);
+
+    if (ports_count == 0) {
+        return -1;
+    }
+
+    // switches are usually connected to a contiguous range of devices
+    if (contiguous_neighbors) {
+        const auto port = dest - neighbors[0];
+        return (0 <= port && port < ports_count) ? port : -1;
+    }
+
+    // binary search over the sorted neighbors
+    const auto* const neighbors_end = neighbors + ports_count;
+    const auto* const neighbor = std::lower_bound(neighbors, neighbors_end, dest);
+    if (neighbor == neighbors_end || *neighbor != dest) {
+        return -1;
+    }
+    return static_cast<int>(neighbor - neighbors);
+}
+
 void Device::send(std::unique_ptr<Chunk> chunk) noexcept {
     // assert the validity of the chunk
     assert(chunk != nullptr);
@@ -31,17 +95,16 @@ void Device::send(std::unique_ptr<Chunk> chunk) noexcept {
     // assert the chunk hasn't arrived its final destination yet
     assert(!chunk->arrived_dest());
 
-    // get next dest
-    const auto next_dest = chunk->next_device();
-    assert(next_dest != nullptr);
-    const auto next_dest_id = next_dest->get_id();
-
-    // assert the next dest is connected to this node
-    assert(connected(next_dest_id));
+    // the port to the next dest is resolved along with the route
+    // the links should have been moved into the LinkStore by now
+    assert(links != nullptr);
+    const auto port = chunk->next_port();
+    assert(0 <= port && port < ports_count);
+    assert(neighbors[port] == chunk->next_device()->get_id());
 
     // send the chunk to the next dest
     // delegate this task to the link
-    links[next_dest_id]->send(std::move(chunk));
+    links[port].send(std::move(chunk));
 }
 
 void Device::connect(const DeviceId id, const Bandwidth bandwidth, const Latency latency, const bool non_blocking) noexcept {
@@ -49,16 +112,37 @@ void Device::connect(const DeviceId id, const Bandwidth bandwidth, const Latency
     assert(bandwidth > 0);
     assert(latency >= 0);
 
+    // links are fixed once the LinkStore is built
+    assert(links == nullptr);
+
     // assert there's no existing connection
     assert(!connected(id));
 
-    // create link
-    links[id] = std::make_shared<Link>(bandwidth, latency, non_blocking);
+    // the link is instantiated once the LinkStore is built
+    pending_links.push_back({id, bandwidth, latency, non_blocking});
 }
 
 bool Device::connected(const DeviceId dest) const noexcept {
     assert(dest >= 0);
 
     // check whether the connection exists
-    return links.find(dest) != links.end();
+    if (links != nullptr) {
+        return get_port(dest) >= 0;
+    }
+    return std::any_of(pending_links.begin(), pending_links.end(),
+                       [dest](const PendingLink& pending_link) noexcept { return pending_link.dest == dest; });
+}
+
+void Device::bind_links(Link* const links, const DeviceId* const neighbors, const int ports_count) noexcept {
+    assert(ports_count >= 0);
+
+    this->links = links;
+    this->neighbors = neighbors;
+    this->ports_count = ports_count;
+
+    // neighbors are sorted and unique, so they're contiguous iff the range spans exactly ports_count ids
+    contiguous_neighbors = (ports_count > 0) && (neighbors[ports_count - 1] - neighbors[0] == ports_count - 1);
+
+    pending_links.clear();
+    pending_links.shrink_to_fit();
 }
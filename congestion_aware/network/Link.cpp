@@ -7,15 +7,13 @@ LICENSE file in the root directory of this source tree.
 #include "common/NetworkFunction.h"
 #include "congestion_aware/Chunk.h"
 #include "congestion_aware/Device.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
 
-// declaring static event_queue
-std::shared_ptr<EventQueue> Link::event_queue;
-
 void Link::link_become_free(void* const link_ptr) noexcept {
     assert(link_ptr != nullptr);
 
@@ -31,34 +29,124 @@ void Link::link_become_free(void* const link_ptr) noexcept {
     }
 }
 
-void Link::set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept {
-    assert(event_queue_ptr != nullptr);
+void Link::transmission_complete(void* const link_ptr) noexcept {
+    assert(link_ptr != nullptr);
 
-    // set the event queue
-    Link::event_queue = std::move(event_queue_ptr);
+    // cast to Link*
+    auto* const link = static_cast<Link*>(link_ptr);
+    assert(link->transmitting_chunk != nullptr);
+
+    // deliver the chunk, then free the link (in the same order as separate events would)
+    auto* const chunk_ptr = static_cast<void*>(link->transmitting_chunk.release());
+    Chunk::chunk_arrived_next_device(chunk_ptr);
+    link_become_free(link_ptr);
 }
 
-Link::Link(const Bandwidth bandwidth, const Latency latency, const bool non_blocking) noexcept
-    : bandwidth(bandwidth),
+Link::Link(const Bandwidth bandwidth,
+           const Latency latency,
+           const bool non_blocking,
+           std::shared_ptr<SimulationContext> context) noexcept
+    : context(std::move(context)),
+      bandwidth(bandwidth),
       latency(latency),
       non_blocking(non_blocking),
-      pending_chunks(),
-      busy(false) {
+      busy(false),
+      transmitting_chunk(nullptr),
+      virtual_channels(1),
+      arbitration(VirtualChannelArbitration::RoundRobin),
+      next_virtual_channel(0),
+      pending_chunks_count(0) {
     assert(bandwidth > 0);
     assert(latency >= 0);
+    assert(this->context != nullptr);
 
     // convert bandwidth from GB/s to B/ns
     bandwidth_Bpns = bw_GBps_to_Bpns(bandwidth);
 }
 
+Latency Link::get_latency() const noexcept {
+    return latency;
+}
+
+Bandwidth Link::get_bandwidth_Bpns() const noexcept {
+    return bandwidth_Bpns;
+}
+
+bool Link::is_non_blocking() const noexcept {
+    return non_blocking;
+}
+
+void Link::set_simulation_context(std::shared_ptr<SimulationContext> context) noexcept {
+    assert(context != nullptr);
+
+    this->context = std::move(context);
+}
+
+void Link::set_virtual_channels(const int virtual_channels_count,
+                                const VirtualChannelArbitration arbitration) noexcept {
+    assert(virtual_channels_count > 0);
+    assert(pending_chunks_count == 0);
+
+    virtual_channels.resize(virtual_channels_count);
+    this->arbitration = arbitration;
+    next_virtual_channel = 0;
+}
+
+int Link::get_virtual_channels_count() const noexcept {
+    return static_cast<int>(virtual_channels.size());
+}
+
+VirtualChannelStats Link::get_virtual_channel_stats(const int virtual_channel) const noexcept {
+    assert(0 <= virtual_channel && virtual_channel < get_virtual_channels_count());
+
+    const auto& channel = virtual_channels[virtual_channel];
+    const auto current_time = context->get_current_time();
+    const auto occupancy = static_cast<uint64_t>(channel.pending_chunks.size());
+
+    // account the occupancy since the last change
+    const auto occupancy_area =
+        channel.occupancy_area + static_cast<double>(occupancy) * (current_time - channel.last_update_time);
+
+    auto stats = VirtualChannelStats();
+    stats.enqueued_chunks_count = channel.enqueued_chunks_count;
+    stats.occupancy = occupancy;
+    stats.peak_occupancy = channel.peak_occupancy;
+    stats.average_occupancy = (current_time > 0) ? occupancy_area / current_time : 0;
+    return stats;
+}
+
+void Link::set_utilization_window(const EventTime utilization_window) noexcept {
+    telemetry.set_utilization_window(utilization_window);
+}
+
+LinkTelemetry Link::get_telemetry() const noexcept {
+    if constexpr (link_telemetry_enabled) {
+        return telemetry.get_telemetry(context->get_current_time());
+    }
+
+    return LinkTelemetry();
+}
+
 void Link::send(std::unique_ptr<Chunk> chunk) noexcept {
     assert(chunk != nullptr);
 
     if (busy) {
-        // link is busy, add to pending chunks
+        // link is busy, add to the pending chunks of its virtual channel
         chunk->stall_count++;
-        chunk->stall_time_begin = Link::event_queue->get_current_time();
-        pending_chunks.push_back(std::move(chunk));
+        chunk->stall_time_begin = context->get_current_time();
+
+        const auto last_virtual_channel = get_virtual_channels_count() - 1;
+        auto& channel = virtual_channels[std::min(chunk->get_virtual_channel(), last_virtual_channel)];
+        account_occupancy(channel);
+        channel.pending_chunks.push_back(std::move(chunk));
+        channel.enqueued_chunks_count++;
+        channel.peak_occupancy = std::max<uint64_t>(channel.peak_occupancy, channel.pending_chunks.size());
+        pending_chunks_count++;
+
+        if constexpr (link_telemetry_enabled) {
+            telemetry.record_stall();
+            telemetry.record_pending_chunks(pending_chunks_count, context->get_current_time());
+        }
     } else {
         // service this chunk immediately
         schedule_chunk_transmission(std::move(chunk));
@@ -69,10 +157,29 @@ void Link::process_pending_transmission() noexcept {
     // pending chunk should exist
     assert(pending_chunk_exists());
 
+    // choose the virtual channel to serve
+    const auto virtual_channels_count = get_virtual_channels_count();
+    auto virtual_channel = (arbitration == VirtualChannelArbitration::RoundRobin) ? next_virtual_channel : 0;
+    while (virtual_channels[virtual_channel].pending_chunks.empty()) {
+        virtual_channel = (virtual_channel + 1) % virtual_channels_count;
+    }
+    next_virtual_channel = (virtual_channel + 1) % virtual_channels_count;
+
     // get chunk to process
-    auto chunk = std::move(pending_chunks.front());
-    chunk->stall_times += (Link::event_queue->get_current_time() - chunk->stall_time_begin);
-    pending_chunks.pop_front();
+    auto& channel = virtual_channels[virtual_channel];
+    account_occupancy(channel);
+    auto chunk = channel.pending_chunks.pop_front();
+    const auto current_time = context->get_current_time();
+    chunk->stall_times += (current_time - chunk->stall_time_begin);
+    pending_chunks_count--;
+
+    if (auto* const chrome_trace_writer = context->get_chrome_trace_writer(); chrome_trace_writer != nullptr) {
+        chrome_trace_writer->write_stall(*chunk, chunk->stall_time_begin, current_time);
+    }
+
+    if constexpr (link_telemetry_enabled) {
+        telemetry.record_pending_chunks(pending_chunks_count, current_time);
+    }
 
     // service this chunk
     schedule_chunk_transmission(std::move(chunk));
@@ -80,7 +187,7 @@ void Link::process_pending_transmission() noexcept {
 
 bool Link::pending_chunk_exists() const noexcept {
     // check pending chunks is not empty
-    return !pending_chunks.empty();
+    return pending_chunks_count > 0;
 }
 
 void Link::set_busy() noexcept {
@@ -127,9 +234,15 @@ void Link::schedule_chunk_transmission(std::unique_ptr<Chunk> chunk) noexcept {
     if (!non_blocking)
         set_busy();
 
+    // packets pipeline through the route
+    if (chunk->get_packet_size() > 0) {
+        schedule_packets_transmission(std::move(chunk));
+        return;
+    }
+
     // get metadata
     const auto chunk_size = chunk->get_size();
-    const auto current_time = Link::event_queue->get_current_time();
+    const auto current_time = context->get_current_time();
 
     const auto last_bpns = chunk->last_bpns;
     chunk->last_bpns = bandwidth_Bpns;
@@ -140,13 +253,81 @@ void Link::schedule_chunk_transmission(std::unique_ptr<Chunk> chunk) noexcept {
     const auto chunk_arrival_time = current_time + latency + serialization_time;
     const auto link_free_time = chunk_arrival_time;
 
-    if (chunk->src_device_id == 0){
-        auto cnt = 1;
+    if constexpr (link_telemetry_enabled) {
+        telemetry.record_transmission(chunk_size, current_time, link_free_time);
+    }
+    if (auto* const chrome_trace_writer = context->get_chrome_trace_writer(); chrome_trace_writer != nullptr) {
+        chrome_trace_writer->write_transmission(this, *chunk, current_time, link_free_time);
+    }
+
+    auto* const next_context = chunk->next_device()->get_simulation_context();
+    auto* const link_ptr = static_cast<void*>(this);
+
+    // a non-blocking link never becomes busy, so there's nothing to do once it's free
+    if (non_blocking) {
+        auto* const chunk_ptr = static_cast<void*>(chunk.release());
+        next_context->schedule_event(chunk_arrival_time, Chunk::chunk_arrived_next_device, chunk_ptr);
+        return;
     }
 
+    // a blocking link carries a single chunk at a time, and becomes free as the chunk arrives:
+    // a single event delivers the chunk and frees the link, if both belong to the same simulation
+    if (next_context == context.get()) {
+        assert(transmitting_chunk == nullptr);
+        transmitting_chunk = std::move(chunk);
+        context->schedule_event(chunk_arrival_time, transmission_complete, link_ptr);
+        return;
+    }
+
+    // chunk arrival is handled by the simulation of the next device
+    auto* const chunk_ptr = static_cast<void*>(chunk.release());
+    next_context->schedule_event(chunk_arrival_time, Chunk::chunk_arrived_next_device, chunk_ptr);
+    context->schedule_event(link_free_time, link_become_free, link_ptr);
+}
+
+void Link::schedule_packets_transmission(std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+    assert(chunk->get_packet_size() > 0);
+
+    // get metadata
+    const auto chunk_size = static_cast<double>(chunk->get_size());
+    const auto packet_size = static_cast<double>(std::min(chunk->get_size(), chunk->get_packet_size()));
+    const auto current_time = static_cast<double>(context->get_current_time());
+    const auto packet_serialization_time = packet_size / bandwidth_Bpns;
+
+    // the head packet is forwarded as soon as it's serialized (virtual cut-through),
+    // while the last packet can't be serialized before it fully arrives at this device
+    const auto head_arrival_time = current_time + packet_serialization_time + latency;
+    const auto tail_sent_time = std::max(current_time + chunk_size / bandwidth_Bpns,
+                                         static_cast<double>(chunk->tail_arrival_time) + packet_serialization_time);
+    chunk->tail_arrival_time = static_cast<EventTime>(tail_sent_time + latency);
+
+    // the link is occupied until the last packet is sent,
+    // and only the arrival of the last packet matters at the dest
+    const auto link_free_time = static_cast<EventTime>(tail_sent_time);
+    const auto chunk_arrival_time =
+        chunk->next_device_is_dest() ? chunk->tail_arrival_time : static_cast<EventTime>(head_arrival_time);
+
+    if constexpr (link_telemetry_enabled) {
+        telemetry.record_transmission(chunk->get_size(), static_cast<EventTime>(current_time), link_free_time);
+    }
+    if (auto* const chrome_trace_writer = context->get_chrome_trace_writer(); chrome_trace_writer != nullptr) {
+        chrome_trace_writer->write_transmission(this, *chunk, static_cast<EventTime>(current_time), link_free_time);
+    }
+
+    // chunk arrival is handled by the simulation of the next device
+    auto* const next_context = chunk->next_device()->get_simulation_context();
     auto* const chunk_ptr = static_cast<void*>(chunk.release());
-    Link::event_queue->schedule_event(chunk_arrival_time, Chunk::chunk_arrived_next_device, chunk_ptr);
+    next_context->schedule_event(chunk_arrival_time, Chunk::chunk_arrived_next_device, chunk_ptr);
 
     auto* const link_ptr = static_cast<void*>(this);
-    Link::event_queue->schedule_event(link_free_time, link_become_free, link_ptr);
+    context->schedule_event(link_free_time, link_become_free, link_ptr);
+}
+
+void Link::account_occupancy(VirtualChannel& virtual_channel) noexcept {
+    const auto current_time = context->get_current_time();
+    const auto occupancy = static_cast<double>(virtual_channel.pending_chunks.size());
+
+    virtual_channel.occupancy_area += occupancy * (current_time - virtual_channel.last_update_time);
+    virtual_channel.last_update_time = current_time;
 }
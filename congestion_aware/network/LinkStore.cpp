@@ -0,0 +1,58 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/LinkStore.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Device.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+LinkStore::LinkStore(const std::vector<std::shared_ptr<Device>>& devices) noexcept {
+    const auto devices_count = devices.size();
+
+    // sort links of each device by dest, and compute row offsets
+    offsets.resize(devices_count + 1);
+    offsets[0] = 0;
+    for (size_t i = 0; i < devices_count; i++) {
+        auto& pending_links = devices[i]->pending_links;
+        std::sort(pending_links.begin(), pending_links.end(),
+                  [](const Device::PendingLink& lhs, const Device::PendingLink& rhs) noexcept {
+                      return lhs.dest < rhs.dest;
+                  });
+        offsets[i + 1] = offsets[i] + pending_links.size();
+    }
+
+    // instantiate links contiguously
+    // reserved upfront, so that links never move once bound to devices
+    const auto links_count = offsets[devices_count];
+    neighbors.reserve(links_count);
+    links.reserve(links_count);
+    for (const auto& device : devices) {
+        for (const auto& pending_link : device->pending_links) {
+            neighbors.push_back(pending_link.dest);
+            links.emplace_back(pending_link.bandwidth, pending_link.latency, pending_link.non_blocking,
+                               device->context);
+        }
+    }
+    assert(links.size() == links_count);
+
+    // bind each device to its row
+    for (size_t i = 0; i < devices_count; i++) {
+        const auto ports_count = static_cast<int>(offsets[i + 1] - offsets[i]);
+        devices[i]->bind_links(links.data() + offsets[i], neighbors.data() + offsets[i], ports_count);
+    }
+}
+
+size_t LinkStore::get_links_count() const noexcept {
+    return links.size();
+}
+
+Link& LinkStore::get_link(const size_t index) noexcept {
+    assert(index < links.size());
+
+    return links[index];
+}
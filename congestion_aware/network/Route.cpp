@@ -0,0 +1,192 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/Route.h"
+#include "congestion_aware/Device.h"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+Route::Route() noexcept
+    : heap_devices(nullptr),
+      heap_ports(nullptr),
+      ports_resolved(false),
+      devices_count(0),
+      capacity(inline_capacity),
+      cursor(0) {}
+
+Route::Route(const Route& route) noexcept : Route() {
+    copy_from(route);
+}
+
+Route::Route(Route&& route) noexcept : Route() {
+    *this = std::move(route);
+}
+
+Route& Route::operator=(const Route& route) noexcept {
+    if (this != &route) {
+        copy_from(route);
+    }
+    return *this;
+}
+
+Route& Route::operator=(Route&& route) noexcept {
+    if (this == &route) {
+        return *this;
+    }
+
+    // steal the heap storage, if any
+    if (route.heap_devices != nullptr) {
+        heap_devices = std::move(route.heap_devices);
+        heap_ports = std::move(route.heap_ports);
+        capacity = route.capacity;
+    } else {
+        heap_devices = nullptr;
+        heap_ports = nullptr;
+        capacity = inline_capacity;
+        std::copy(route.inline_devices, route.inline_devices + route.devices_count, inline_devices);
+        if (route.ports_resolved && route.devices_count > 0) {
+            std::copy(route.inline_ports, route.inline_ports + route.devices_count - 1, inline_ports);
+        }
+    }
+    devices_count = route.devices_count;
+    cursor = route.cursor;
+    ports_resolved = route.ports_resolved;
+
+    route.capacity = inline_capacity;
+    route.devices_count = 0;
+    route.cursor = 0;
+    route.ports_resolved = false;
+    return *this;
+}
+
+void Route::push_back(Device* const device) noexcept {
+    assert(device != nullptr);
+
+    // ports are resolved once the route is complete
+    assert(!ports_resolved);
+
+    // grow into the heap
+    if (devices_count == capacity) {
+        const auto new_capacity = capacity * 2;
+        auto new_heap_devices = std::make_unique<Device*[]>(new_capacity);
+        std::copy(data(), data() + devices_count, new_heap_devices.get());
+        heap_devices = std::move(new_heap_devices);
+        heap_ports = std::make_unique<int32_t[]>(new_capacity);
+        capacity = new_capacity;
+    }
+
+    auto* const devices = (heap_devices != nullptr) ? heap_devices.get() : inline_devices;
+    devices[devices_count++] = device;
+}
+
+void Route::push_back(const std::shared_ptr<Device>& device) noexcept {
+    push_back(device.get());
+}
+
+Device* Route::front() const noexcept {
+    assert(!empty());
+
+    return data()[cursor];
+}
+
+Device* Route::next() const noexcept {
+    assert(size() >= 2);
+
+    return data()[cursor + 1];
+}
+
+int Route::next_port() const noexcept {
+    assert(size() >= 2);
+    assert(ports_resolved);
+
+    return ports_data()[cursor];
+}
+
+void Route::resolve_ports() noexcept {
+    const auto* const devices = data();
+    auto* const ports = ports_data();
+    for (uint32_t i = 0; i + 1 < devices_count; i++) {
+        ports[i] = devices[i]->get_port(devices[i + 1]->get_id());
+        assert(ports[i] >= 0);
+    }
+    ports_resolved = true;
+}
+
+void Route::set_ports(const int32_t* const ports) noexcept {
+    assert(ports != nullptr);
+
+    if (devices_count > 0) {
+        std::copy(ports, ports + devices_count - 1, ports_data());
+    }
+    ports_resolved = true;
+}
+
+bool Route::has_ports() const noexcept {
+    return ports_resolved;
+}
+
+Device* Route::back() const noexcept {
+    assert(!empty());
+
+    return data()[devices_count - 1];
+}
+
+void Route::advance() noexcept {
+    assert(!empty());
+
+    cursor++;
+}
+
+size_t Route::size() const noexcept {
+    return devices_count - cursor;
+}
+
+bool Route::empty() const noexcept {
+    return cursor == devices_count;
+}
+
+Device* const* Route::begin() const noexcept {
+    return data() + cursor;
+}
+
+Device* const* Route::end() const noexcept {
+    return data() + devices_count;
+}
+
+Device* const* Route::data() const noexcept {
+    return (heap_devices != nullptr) ? heap_devices.get() : inline_devices;
+}
+
+int32_t* Route::ports_data() noexcept {
+    return (heap_devices != nullptr) ? heap_ports.get() : inline_ports;
+}
+
+const int32_t* Route::ports_data() const noexcept {
+    return (heap_devices != nullptr) ? heap_ports.get() : inline_ports;
+}
+
+void Route::copy_from(const Route& route) noexcept {
+    if (route.devices_count > inline_capacity) {
+        heap_devices = std::make_unique<Device*[]>(route.devices_count);
+        heap_ports = std::make_unique<int32_t[]>(route.devices_count);
+        capacity = route.devices_count;
+    } else {
+        heap_devices = nullptr;
+        heap_ports = nullptr;
+        capacity = inline_capacity;
+    }
+
+    auto* const devices = (heap_devices != nullptr) ? heap_devices.get() : inline_devices;
+    std::copy(route.data(), route.data() + route.devices_count, devices);
+    if (route.ports_resolved && route.devices_count > 0) {
+        std::copy(route.ports_data(), route.ports_data() + route.devices_count - 1, ports_data());
+    }
+    devices_count = route.devices_count;
+    cursor = route.cursor;
+    ports_resolved = route.ports_resolved;
+}
@@ -0,0 +1,58 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/SimulationContext.h"
+#include <cassert>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+SimulationContext::SimulationContext(std::shared_ptr<EventQueue> event_queue,
+                                     std::shared_ptr<TraceWriter> trace_writer) noexcept
+    : event_queue(std::move(event_queue)),
+      chunk_pool(),
+      trace_writer(std::move(trace_writer)),
+      chrome_trace_writer(nullptr) {
+    assert(this->event_queue != nullptr);
+}
+
+SimulationContext::SimulationContext(std::shared_ptr<TraceWriter> trace_writer) noexcept
+    : event_queue(nullptr),
+      chunk_pool(),
+      trace_writer(std::move(trace_writer)),
+      chrome_trace_writer(nullptr) {}
+
+EventQueue* SimulationContext::get_event_queue() const noexcept {
+    return event_queue.get();
+}
+
+EventTime SimulationContext::get_current_time() const noexcept {
+    assert(event_queue != nullptr);
+
+    return event_queue->get_current_time();
+}
+
+void SimulationContext::schedule_event(const EventTime event_time,
+                                       const Callback callback,
+                                       const CallbackArg callback_arg) const noexcept {
+    assert(event_queue != nullptr);
+
+    event_queue->schedule_event(event_time, callback, callback_arg);
+}
+
+ChunkPool* SimulationContext::get_chunk_pool() noexcept {
+    return &chunk_pool;
+}
+
+TraceWriter* SimulationContext::get_trace_writer() const noexcept {
+    return trace_writer.get();
+}
+
+void SimulationContext::set_chrome_trace_writer(std::shared_ptr<ChromeTraceWriter> chrome_trace_writer) noexcept {
+    this->chrome_trace_writer = std::move(chrome_trace_writer);
+}
+
+ChromeTraceWriter* SimulationContext::get_chrome_trace_writer() const noexcept {
+    return chrome_trace_writer.get();
+}
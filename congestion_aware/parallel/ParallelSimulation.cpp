@@ -0,0 +1,861 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/ParallelSimulation.h"
+#include "common/MemoryPool.h"
+#include "congestion_aware/Link.h"
+#include "congestion_aware/SimulationContext.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/// time no event will ever be scheduled at
+constexpr auto infinite_time = std::numeric_limits<EventTime>::max();
+
+/**
+ * Bookkeeping of a processed event, kept alive until the event is ranked
+ * and every child event it has scheduled is processed and ranked as well.
+ */
+struct EventRecord {
+    /// time the event was processed at
+    EventTime time;
+
+    /// event which scheduled this event, nullptr if scheduled from outside of the simulation
+    EventRecord* parent;
+
+    /// time of the parent event
+    EventTime parent_time;
+
+    /// order among the events scheduled from outside of the simulation (only for those without parent)
+    uint64_t root_index;
+
+    /// index among the events scheduled by the parent event
+    uint32_t child_index;
+
+    /// order among the events processed by the same partition
+    uint64_t local_index;
+
+    /// order among the events of the same time processed by all partitions, valid once ranked
+    uint64_t rank;
+
+    /// whether the event is ranked
+    bool ranked;
+
+    /// number of events scheduled by this event so far
+    uint32_t children_count;
+
+    /// number of references: one until ranked, plus one per child event not ranked yet
+    uint32_t references_count;
+
+    /// partition which processed the event
+    Partition* owner;
+};
+
+/**
+ * Event waiting in the queue of a partition.
+ */
+struct PendingEvent {
+    /// callback to invoke
+    Callback callback;
+
+    /// argument of the callback
+    CallbackArg callback_arg;
+
+    /// event which scheduled this event, nullptr if scheduled from outside of the simulation
+    EventRecord* parent;
+
+    /// time of the parent event
+    EventTime parent_time;
+
+    /// order among the events scheduled from outside of the simulation (only for those without parent)
+    uint64_t root_index;
+
+    /// index among the events scheduled by the parent event
+    uint32_t child_index;
+};
+
+/**
+ * Partition is a set of devices simulated by a single thread, with its own event queue.
+ */
+class Partition {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param index index of the partition
+     * @param partitions_count number of partitions
+     * @param roots_count counter of the events scheduled from outside of the simulation
+     */
+    Partition(int index, int partitions_count, uint64_t* roots_count) noexcept;
+
+    /**
+     * Get the simulation context handed to the devices of the partition.
+     *
+     * @return simulation context
+     */
+    [[nodiscard]] std::shared_ptr<SimulationContext> get_context() const noexcept;
+
+    /**
+     * Get the time of the last processed event.
+     *
+     * @return current time
+     */
+    [[nodiscard]] EventTime get_current_time() const noexcept;
+
+    /**
+     * Get the earliest pending event time, as of the last window boundary.
+     *
+     * @return earliest pending event time, infinite_time if no event is pending
+     */
+    [[nodiscard]] EventTime get_next_event_time() const noexcept;
+
+    /**
+     * Get the number of processed events.
+     *
+     * @return number of processed events
+     */
+    [[nodiscard]] uint64_t get_events_count() const noexcept;
+
+    /**
+     * Get the events processed during the last window, in processing order.
+     *
+     * @return processed events
+     */
+    [[nodiscard]] std::vector<EventRecord*>& get_processed_events() noexcept;
+
+    /**
+     * Schedule an event into this partition.
+     * Called by the thread of the partition processing the parent event,
+     * or by the main thread outside of the simulation.
+     *
+     * @param event_time time of the event
+     * @param callback callback to invoke
+     * @param callback_arg argument of the callback
+     */
+    void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept;
+
+    /**
+     * Process every pending event earlier than window_end.
+     *
+     * @param window_end end of the window (exclusive)
+     */
+    void process_window(EventTime window_end) noexcept;
+
+    /**
+     * Move the events other partitions scheduled into this partition during the last window
+     * into the queue, and update the earliest pending event time.
+     *
+     * @param partitions every partition of the simulation
+     */
+    void receive_events(const std::vector<std::unique_ptr<Partition>>& partitions) noexcept;
+
+    /**
+     * Drop the references to the events processed during the last window, now that they are ranked,
+     * and to their parent events.
+     */
+    void release_processed_events() noexcept;
+
+    /**
+     * Drop the references other partitions have released to the events processed by this partition.
+     *
+     * @param partitions every partition of the simulation
+     */
+    void receive_released_events(const std::vector<std::unique_ptr<Partition>>& partitions) noexcept;
+
+  private:
+    /// index of the partition
+    int index;
+
+    /// counter of the events scheduled from outside of the simulation
+    uint64_t* roots_count;
+
+    /// simulation context of the partition
+    std::shared_ptr<SimulationContext> context;
+
+    /// time of the last processed event
+    EventTime current_time;
+
+    /// end of the window being processed
+    EventTime window_end;
+
+    /// earliest pending event time, as of the last window boundary
+    EventTime next_event_time;
+
+    /// pending events per each time
+    std::map<EventTime, std::vector<PendingEvent>> pending_events;
+
+    /// events of current_time being processed
+    std::vector<PendingEvent> current_events;
+
+    /// event being processed
+    EventRecord* current_record;
+
+    /// number of processed events
+    uint64_t events_count;
+
+    /// events processed during the current window
+    std::vector<EventRecord*> processed_events;
+
+    /// events scheduled into other partitions during the current window, per each destination partition
+    std::vector<std::vector<std::pair<EventTime, PendingEvent>>> outboxes;
+
+    /// events processed by other partitions whose references were dropped, per each owner partition
+    std::vector<std::vector<EventRecord*>> released_events;
+
+    /// storage of processed event records
+    MemoryPool record_pool;
+
+    /**
+     * Drop a reference to a processed event, and free it once unreferenced.
+     * References to events of other partitions are handed over to their owner.
+     *
+     * @param record processed event
+     */
+    void release(EventRecord* record) noexcept;
+
+    /**
+     * Check whether a pending event is processed earlier than the other one of the same time.
+     *
+     * @param lhs pending event
+     * @param rhs pending event
+     * @return true if lhs precedes rhs
+     */
+    static bool precedes(const PendingEvent& lhs, const PendingEvent& rhs) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
+
+namespace {
+
+/// partition whose events the current thread is processing
+thread_local Partition* running_partition = nullptr;
+
+/**
+ * PartitionContext is the simulation context of devices in a partition,
+ * which forwards time and scheduling to the partition.
+ */
+class PartitionContext final : public SimulationContext {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param partition partition the context belongs to
+     */
+    explicit PartitionContext(Partition* const partition) noexcept
+        : SimulationContext(std::shared_ptr<TraceWriter>()),
+          partition(partition) {
+        assert(partition != nullptr);
+    }
+
+    [[nodiscard]] EventTime get_current_time() const noexcept override {
+        return partition->get_current_time();
+    }
+
+    void schedule_event(const EventTime event_time,
+                        const Callback callback,
+                        const CallbackArg callback_arg) const noexcept override {
+        partition->schedule_event(event_time, callback, callback_arg);
+    }
+
+  private:
+    /// partition the context belongs to
+    Partition* partition;
+};
+
+/**
+ * Barrier blocks threads until all of them arrive.
+ * Windows are short, so waiting threads spin for a while before yielding.
+ */
+class Barrier {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param threads_count number of threads to wait for
+     */
+    explicit Barrier(const int threads_count) noexcept : threads_count(threads_count), arrived(0), generation(0) {}
+
+    /**
+     * Wait until every thread arrives.
+     */
+    void wait() noexcept {
+        const auto current_generation = generation.load(std::memory_order_acquire);
+
+        // the last thread to arrive releases the others
+        if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == threads_count) {
+            arrived.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+
+        auto spins = 0;
+        while (generation.load(std::memory_order_acquire) == current_generation) {
+            if (++spins > 1024) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+  private:
+    /// number of threads to wait for
+    int threads_count;
+
+    /// number of threads arrived at the current generation
+    std::atomic<int> arrived;
+
+    /// number of times the barrier has released the threads
+    std::atomic<uint64_t> generation;
+};
+
+/**
+ * Sort key of an event among the events of the same time,
+ * given the order of its parent event.
+ */
+using EventKey = std::tuple<bool, EventTime, uint64_t, uint32_t>;
+
+/**
+ * Check whether an event processed during the current window was processed earlier than the other one of
+ * the same time. Parents processed during the current window may not be ranked yet (or are being ranked
+ * by another thread), so they are compared the same way instead of by their rank.
+ *
+ * @param lhs processed event
+ * @param rhs processed event
+ * @param window_start start of the current window
+ * @return true if lhs precedes rhs
+ */
+bool processed_earlier(const EventRecord* lhs, const EventRecord* rhs, const EventTime window_start) noexcept {
+    while (true) {
+        assert(lhs->time == rhs->time);
+
+        // a partition processes events in the sequential order
+        if (lhs->owner == rhs->owner) {
+            return lhs->local_index < rhs->local_index;
+        }
+
+        // events scheduled from outside of the simulation come first
+        if (lhs->parent == nullptr || rhs->parent == nullptr) {
+            if (lhs->parent != rhs->parent) {
+                return lhs->parent == nullptr;
+            }
+            return lhs->root_index < rhs->root_index;
+        }
+
+        if (lhs->parent_time != rhs->parent_time) {
+            return lhs->parent_time < rhs->parent_time;
+        }
+        if (lhs->parent == rhs->parent) {
+            return lhs->child_index < rhs->child_index;
+        }
+
+        // parents of earlier windows are ranked already
+        if (lhs->parent_time < window_start) {
+            assert(lhs->parent->ranked && rhs->parent->ranked);
+            return lhs->parent->rank < rhs->parent->rank;
+        }
+
+        // parents of the current window are of the same time, processed by different partitions
+        lhs = lhs->parent;
+        rhs = rhs->parent;
+    }
+}
+
+}  // namespace
+
+Partition::Partition(const int index, const int partitions_count, uint64_t* const roots_count) noexcept
+    : index(index),
+      roots_count(roots_count),
+      current_time(0),
+      window_end(0),
+      next_event_time(infinite_time),
+      current_record(nullptr),
+      events_count(0) {
+    assert(index >= 0);
+    assert(partitions_count > index);
+    assert(roots_count != nullptr);
+
+    context = std::make_shared<PartitionContext>(this);
+    outboxes.resize(partitions_count);
+    released_events.resize(partitions_count);
+}
+
+std::shared_ptr<SimulationContext> Partition::get_context() const noexcept {
+    return context;
+}
+
+EventTime Partition::get_current_time() const noexcept {
+    return current_time;
+}
+
+EventTime Partition::get_next_event_time() const noexcept {
+    return next_event_time;
+}
+
+uint64_t Partition::get_events_count() const noexcept {
+    return events_count;
+}
+
+std::vector<EventRecord*>& Partition::get_processed_events() noexcept {
+    return processed_events;
+}
+
+void Partition::schedule_event(const EventTime event_time,
+                               const Callback callback,
+                               const CallbackArg callback_arg) noexcept {
+    assert(callback != nullptr);
+
+    auto event = PendingEvent{callback, callback_arg, nullptr, 0, 0, 0};
+    auto* const source = running_partition;
+
+    // scheduled from outside of the simulation, e.g., a chunk sent before running
+    if (source == nullptr) {
+        event.root_index = (*roots_count)++;
+        pending_events[event_time].push_back(event);
+        next_event_time = std::min(next_event_time, event_time);
+        return;
+    }
+
+    // scheduled by the event being processed
+    auto* const parent = source->current_record;
+    assert(parent != nullptr);
+    event.parent = parent;
+    event.parent_time = parent->time;
+    event.child_index = parent->children_count++;
+    parent->references_count++;
+
+    if (source != this) {
+        // cross-partition event: lookahead guarantees it's beyond the current window
+        assert(event_time >= source->window_end);
+        source->outboxes[index].emplace_back(event_time, event);
+        return;
+    }
+
+    assert(event_time >= current_time);
+    if (event_time == current_time) {
+        // processed within the current batch, after every event already there
+        current_events.push_back(event);
+    } else {
+        pending_events[event_time].push_back(event);
+    }
+}
+
+void Partition::process_window(const EventTime window_end) noexcept {
+    assert(running_partition == this);
+
+    this->window_end = window_end;
+
+    while (!pending_events.empty() && pending_events.begin()->first < window_end) {
+        // take the events of the earliest time
+        auto node = pending_events.extract(pending_events.begin());
+        current_time = node.key();
+        current_events = std::move(node.mapped());
+
+        // order them as the sequential engine would
+        std::sort(current_events.begin(), current_events.end(), precedes);
+
+        // events scheduled at current_time are appended while iterating
+        for (size_t i = 0; i < current_events.size(); i++) {
+            const auto event = current_events[i];
+
+            auto* const record = new (record_pool.allocate(sizeof(EventRecord))) EventRecord();
+            record->time = current_time;
+            record->parent = event.parent;
+            record->parent_time = event.parent_time;
+            record->root_index = event.root_index;
+            record->child_index = event.child_index;
+            record->local_index = events_count++;
+            record->rank = 0;
+            record->ranked = false;
+            record->children_count = 0;
+            record->references_count = 1;
+            record->owner = this;
+
+            current_record = record;
+            event.callback(event.callback_arg);
+            processed_events.push_back(record);
+        }
+
+        current_record = nullptr;
+        current_events.clear();
+    }
+}
+
+void Partition::receive_events(const std::vector<std::unique_ptr<Partition>>& partitions) noexcept {
+    for (const auto& partition : partitions) {
+        auto& outbox = partition->outboxes[index];
+        for (const auto& [event_time, event] : outbox) {
+            pending_events[event_time].push_back(event);
+        }
+        outbox.clear();
+    }
+
+    next_event_time = pending_events.empty() ? infinite_time : pending_events.begin()->first;
+}
+
+void Partition::release_processed_events() noexcept {
+    // ranked events no longer need their parents
+    for (auto* const record : processed_events) {
+        if (record->parent != nullptr) {
+            release(record->parent);
+            record->parent = nullptr;
+        }
+        release(record);
+    }
+    processed_events.clear();
+}
+
+void Partition::receive_released_events(const std::vector<std::unique_ptr<Partition>>& partitions) noexcept {
+    for (const auto& partition : partitions) {
+        auto& released = partition->released_events[index];
+        for (auto* const record : released) {
+            release(record);
+        }
+        released.clear();
+    }
+}
+
+void Partition::release(EventRecord* const record) noexcept {
+    assert(record != nullptr);
+
+    // only the owner touches the references, so that no atomics are needed
+    if (record->owner != this) {
+        released_events[record->owner->index].push_back(record);
+        return;
+    }
+
+    assert(record->references_count > 0);
+    record->references_count--;
+    if (record->references_count == 0) {
+        record->owner->record_pool.deallocate(record, sizeof(EventRecord));
+    }
+}
+
+bool Partition::precedes(const PendingEvent& lhs, const PendingEvent& rhs) noexcept {
+    // the sequential engine processes events of the same time in the order they were scheduled:
+    // events scheduled from outside of the simulation first, then by (parent time, parent order, child index).
+    // parents of a window not ranked yet all belong to this partition (cross-partition events
+    // always land in a later window), so their local order agrees with the global one.
+    const auto key = [](const PendingEvent& event) noexcept {
+        if (event.parent == nullptr) {
+            return EventKey(false, 0, event.root_index, 0);
+        }
+        const auto parent_order = event.parent->ranked ? event.parent->rank : event.parent->local_index;
+        return EventKey(true, event.parent_time, parent_order, event.child_index);
+    };
+    return key(lhs) < key(rhs);
+}
+
+ParallelSimulation::ParallelSimulation(std::shared_ptr<Topology> topology, const int threads_count) noexcept
+    : topology(std::move(topology)),
+      lookahead(infinite_time),
+      windows_count(0),
+      roots_count(0) {
+    assert(this->topology != nullptr);
+    assert(threads_count > 0);
+
+    // partitioning walks the ports of each device
+    this->topology->build_link_store();
+    partition_devices(threads_count);
+}
+
+ParallelSimulation::~ParallelSimulation() noexcept = default;
+
+void ParallelSimulation::partition_devices(const int threads_count) noexcept {
+    const auto devices = topology->get_devices();
+    const auto devices_count = static_cast<int>(devices.size());
+    assert(devices_count > 0);
+
+    // index devices by id
+    auto max_device_id = 0;
+    for (const auto& device : devices) {
+        max_device_id = std::max(max_device_id, device->get_id());
+    }
+    auto device_index = std::vector<int>(max_device_id + 1, -1);
+    for (auto i = 0; i < devices_count; i++) {
+        device_index[devices[i]->get_id()] = i;
+    }
+
+    // collect links as (src index, dest index, minimum arrival delay)
+    auto links = std::vector<std::tuple<int, int, EventTime>>();
+    for (auto i = 0; i < devices_count; i++) {
+        for (auto port = 0; port < devices[i]->get_ports_count(); port++) {
+            const auto dest = devices[i]->get_neighbor(port);
+            const auto delay = static_cast<EventTime>(std::floor(devices[i]->get_link(port)->get_latency()));
+            links.emplace_back(i, device_index[dest], delay);
+        }
+    }
+
+    // find connected components of links shorter than the threshold
+    const auto find_components = [&](const EventTime threshold, std::vector<int>& component) noexcept {
+        auto parent = std::vector<int>(devices_count);
+        std::iota(parent.begin(), parent.end(), 0);
+        const auto find = [&parent](int device) noexcept {
+            while (parent[device] != device) {
+                parent[device] = parent[parent[device]];
+                device = parent[device];
+            }
+            return device;
+        };
+        for (const auto& [src, dest, delay] : links) {
+            if (delay < threshold) {
+                parent[find(src)] = find(dest);
+            }
+        }
+
+        auto components_count = 0;
+        auto root_component = std::vector<int>(devices_count, -1);
+        component.assign(devices_count, 0);
+        for (auto i = 0; i < devices_count; i++) {
+            const auto root = find(i);
+            if (root_component[root] < 0) {
+                root_component[root] = components_count++;
+            }
+            component[i] = root_component[root];
+        }
+        return components_count;
+    };
+
+    // cut along the longest links which still leave enough components
+    auto thresholds = std::vector<EventTime>();
+    for (const auto& link : links) {
+        if (std::get<2>(link) > 0) {
+            thresholds.push_back(std::get<2>(link));
+        }
+    }
+    std::sort(thresholds.begin(), thresholds.end(), std::greater<>());
+    thresholds.erase(std::unique(thresholds.begin(), thresholds.end()), thresholds.end());
+
+    auto component = std::vector<int>(devices_count, 0);
+    auto components_count = 1;
+    if (threads_count > 1) {
+        for (const auto threshold : thresholds) {
+            components_count = find_components(threshold, component);
+            if (components_count >= threads_count) {
+                break;
+            }
+        }
+    }
+    if (components_count < 2) {
+        component.assign(devices_count, 0);
+        components_count = 1;
+    }
+
+    // deal components, largest first, into the least loaded partition
+    auto component_sizes = std::vector<int>(components_count, 0);
+    for (const auto c : component) {
+        component_sizes[c]++;
+    }
+    auto components = std::vector<int>(components_count);
+    std::iota(components.begin(), components.end(), 0);
+    std::stable_sort(components.begin(), components.end(), [&component_sizes](const int lhs, const int rhs) {
+        return component_sizes[lhs] > component_sizes[rhs];
+    });
+
+    const auto partitions_count = std::min(threads_count, components_count);
+    auto partition_sizes = std::vector<int>(partitions_count, 0);
+    auto component_partition = std::vector<int>(components_count, 0);
+    for (const auto c : components) {
+        const auto partition = static_cast<int>(std::min_element(partition_sizes.begin(), partition_sizes.end()) -
+                                                partition_sizes.begin());
+        component_partition[c] = partition;
+        partition_sizes[partition] += component_sizes[c];
+    }
+
+    // create partitions and move devices into them
+    for (auto i = 0; i < partitions_count; i++) {
+        partitions.push_back(std::make_unique<Partition>(i, partitions_count, &roots_count));
+    }
+    device_partition.assign(max_device_id + 1, 0);
+    for (auto i = 0; i < devices_count; i++) {
+        const auto partition = component_partition[component[i]];
+        device_partition[devices[i]->get_id()] = partition;
+        devices[i]->set_simulation_context(partitions[partition]->get_context());
+    }
+
+    // lookahead: minimum arrival delay of cross-partition links
+    lookahead = infinite_time;
+    for (const auto& [src, dest, delay] : links) {
+        if (component_partition[component[src]] != component_partition[component[dest]]) {
+            lookahead = std::min(lookahead, delay);
+        }
+    }
+    assert(partitions_count == 1 || lookahead > 0);
+
+    // a single partition still proceeds in windows, so that bookkeeping is released periodically
+    if (partitions_count == 1) {
+        lookahead = thresholds.empty() ? 1 : thresholds.back();
+    }
+}
+
+void ParallelSimulation::run() noexcept {
+    const auto partitions_count = static_cast<int>(partitions.size());
+    auto barrier = Barrier(partitions_count);
+
+    const auto simulate = [this, &barrier](const int index) noexcept {
+        auto& partition = *partitions[index];
+        running_partition = &partition;
+
+        while (true) {
+            // every partition computes the same window
+            const auto window_start = get_next_event_time();
+            if (window_start == infinite_time) {
+                break;
+            }
+            const auto window_end =
+                (lookahead >= infinite_time - window_start) ? infinite_time : window_start + lookahead;
+
+            partition.process_window(window_end);
+            barrier.wait();
+
+            // exchange cross-partition events, and rank processed ones in parallel
+            partition.receive_events(partitions);
+            partition.receive_released_events(partitions);
+            rank_processed_events(index, window_start);
+            barrier.wait();
+
+            // records are released by their owner, while other partitions proceed to the next window
+            partition.release_processed_events();
+            if (index == 0) {
+                windows_count++;
+            }
+        }
+
+        running_partition = nullptr;
+    };
+
+    // the calling thread simulates partition 0
+    auto threads = std::vector<std::thread>();
+    for (auto i = 1; i < partitions_count; i++) {
+        threads.emplace_back(simulate, i);
+    }
+    simulate(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // references released during the last window
+    for (const auto& partition : partitions) {
+        partition->receive_released_events(partitions);
+    }
+}
+
+int ParallelSimulation::get_partitions_count() const noexcept {
+    return static_cast<int>(partitions.size());
+}
+
+int ParallelSimulation::get_partition(const DeviceId device_id) const noexcept {
+    assert(0 <= device_id && device_id < static_cast<int>(device_partition.size()));
+
+    return device_partition[device_id];
+}
+
+EventTime ParallelSimulation::get_lookahead() const noexcept {
+    return lookahead;
+}
+
+EventTime ParallelSimulation::get_current_time() const noexcept {
+    auto current_time = EventTime(0);
+    for (const auto& partition : partitions) {
+        current_time = std::max(current_time, partition->get_current_time());
+    }
+    return current_time;
+}
+
+uint64_t ParallelSimulation::get_events_count() const noexcept {
+    auto events_count = uint64_t(0);
+    for (const auto& partition : partitions) {
+        events_count += partition->get_events_count();
+    }
+    return events_count;
+}
+
+uint64_t ParallelSimulation::get_windows_count() const noexcept {
+    return windows_count;
+}
+
+EventTime ParallelSimulation::get_next_event_time() const noexcept {
+    auto next_event_time = infinite_time;
+    for (const auto& partition : partitions) {
+        next_event_time = std::min(next_event_time, partition->get_next_event_time());
+    }
+    return next_event_time;
+}
+
+void ParallelSimulation::rank_processed_events(const int index, const EventTime window_start) noexcept {
+    // events of the same time only need to be ordered among themselves, so each time is ranked independently:
+    // by the only partition which processed events of the time,
+    // or by one of the partitions sharing the time, picked by the time to spread the work
+    const auto partitions_count = partitions.size();
+    const auto& processed_events = partitions[index]->get_processed_events();
+    const auto earlier_time = [](const EventRecord* const record, const EventTime time) noexcept {
+        return record->time < time;
+    };
+
+    auto cursors = std::vector<size_t>(partitions_count, 0);
+    auto begins = std::vector<size_t>(partitions_count, 0);
+    auto ends = std::vector<size_t>(partitions_count, 0);
+    auto sharing_partitions = std::vector<size_t>();
+
+    auto end = size_t(0);
+    for (auto begin = size_t(0); begin < processed_events.size(); begin = end) {
+        // events of the time processed by each partition, each already in the sequential order
+        const auto time = processed_events[begin]->time;
+        sharing_partitions.clear();
+        for (size_t i = 0; i < partitions_count; i++) {
+            const auto& events = partitions[i]->get_processed_events();
+            const auto first = std::lower_bound(events.begin() + cursors[i], events.end(), time, earlier_time);
+            auto last = first;
+            while (last != events.end() && (*last)->time == time) {
+                last++;
+            }
+            begins[i] = first - events.begin();
+            ends[i] = last - events.begin();
+            cursors[i] = ends[i];
+            if (begins[i] < ends[i]) {
+                sharing_partitions.push_back(i);
+            }
+        }
+        end = ends[index];
+
+        const auto ranking_partition = sharing_partitions[time % sharing_partitions.size()];
+        if (ranking_partition != static_cast<size_t>(index)) {
+            continue;
+        }
+
+        // merge them: few partitions share a time, so pick the earliest head by a linear scan
+        auto rank = uint64_t(0);
+        while (true) {
+            auto* earliest = static_cast<EventRecord*>(nullptr);
+            auto earliest_partition = size_t(0);
+            for (const auto i : sharing_partitions) {
+                if (begins[i] == ends[i]) {
+                    continue;
+                }
+                auto* const head = partitions[i]->get_processed_events()[begins[i]];
+                if (earliest == nullptr || processed_earlier(head, earliest, window_start)) {
+                    earliest = head;
+                    earliest_partition = i;
+                }
+            }
+            if (earliest == nullptr) {
+                break;
+            }
+
+            earliest->rank = rank++;
+            earliest->ranked = true;
+            begins[earliest_partition]++;
+        }
+    }
+}
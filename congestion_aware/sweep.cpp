@@ -0,0 +1,392 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/SimulationContext.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/**
+ * A single congestion-aware simulation of the sweep.
+ */
+struct SweepJob {
+    /// path of the network config file
+    std::string network_path;
+
+    /// size of the message each NPU sends to every other NPU
+    ChunkSize message_size;
+};
+
+/**
+ * Result of a single congestion-aware simulation.
+ */
+struct SweepResult {
+    /// number of NPUs in the topology
+    int npus_count;
+
+    /// number of devices in the topology
+    int devices_count;
+
+    /// simulated finish time in ns
+    EventTime finish_time;
+
+    /// number of events processed by the event queue
+    uint64_t events_count;
+
+    /// largest number of chunks in flight at once
+    uint64_t peak_chunks_count;
+
+    /// wall-clock time taken by the simulation in ms
+    double wall_time_ms;
+};
+
+/**
+ * WorkStealingThreadPool runs a batch of independent tasks on a fixed number of threads.
+ *
+ * Tasks are dealt round-robin into per-thread deques.
+ * Each thread pops tasks from the back of its own deque,
+ * and once it runs dry, steals from the front of the others' deques.
+ */
+class WorkStealingThreadPool {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param threads_count number of worker threads
+     */
+    explicit WorkStealingThreadPool(const int threads_count) noexcept : threads_count(threads_count) {
+        for (auto i = 0; i < threads_count; i++) {
+            queues.push_back(std::make_unique<WorkQueue>());
+        }
+    }
+
+    /**
+     * Run task(i) for every i in [0, tasks_count) and wait for all of them.
+     *
+     * @param tasks_count number of tasks
+     * @param task task to run, given the task index
+     */
+    void run(const size_t tasks_count, const std::function<void(size_t)>& task) noexcept {
+        // deal tasks
+        for (size_t i = 0; i < tasks_count; i++) {
+            queues[i % threads_count]->tasks.push_back(i);
+        }
+
+        // launch workers
+        auto workers = std::vector<std::thread>();
+        for (auto worker = 0; worker < threads_count; worker++) {
+            workers.emplace_back([this, worker, &task]() {
+                auto task_index = size_t(0);
+                while (pop(worker, task_index) || steal(worker, task_index)) {
+                    task(task_index);
+                }
+            });
+        }
+
+        // wait for workers
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+  private:
+    /// deque of task indices owned by a worker thread
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    /// number of worker threads
+    int threads_count;
+
+    /// task deque per each worker thread
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+
+    /**
+     * Pop a task from the back of the worker's own deque.
+     *
+     * @param worker worker index
+     * @param task_index popped task index
+     * @return true if a task was popped, false otherwise
+     */
+    bool pop(const int worker, size_t& task_index) noexcept {
+        auto& queue = *queues[worker];
+        const auto lock = std::lock_guard<std::mutex>(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task_index = queue.tasks.back();
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    /**
+     * Steal a task from the front of another worker's deque.
+     *
+     * @param thief worker index of the thief
+     * @param task_index stolen task index
+     * @return true if a task was stolen, false if every deque is empty
+     */
+    bool steal(const int thief, size_t& task_index) noexcept {
+        for (auto i = 1; i < threads_count; i++) {
+            auto& queue = *queues[(thief + i) % threads_count];
+            const auto lock = std::lock_guard<std::mutex>(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task_index = queue.tasks.front();
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+void chunk_arrived_callback(void* const) {}
+
+/**
+ * Run All-Gather (every NPU sends the message to every other NPU) on the given network.
+ *
+ * @param job simulation to run
+ * @param event_queue_type backend of the event queue
+ * @return simulation result
+ */
+SweepResult run_simulation(const SweepJob& job, const EventQueueType event_queue_type) noexcept {
+    const auto start_time = std::chrono::steady_clock::now();
+
+    // instantiate simulation resources
+    const auto event_queue = std::make_shared<EventQueue>(event_queue_type);
+    const auto context = std::make_shared<SimulationContext>(event_queue);
+
+    // parse network config and create topology
+    const auto network_parser = NetworkParser(job.network_path);
+    const auto topology = construct_topology(network_parser, context);
+    const auto npus_count = topology->get_npus_count();
+    auto* const chunk_pool = context->get_chunk_pool();
+
+    // every pair is routed, so cache the routes
+    topology->enable_route_cache();
+
+    // run All-Gather
+    auto chunk_id = 0;
+    for (auto i = 0; i < npus_count; i++) {
+        for (auto j = 0; j < npus_count; j++) {
+            if (i == j) {
+                continue;
+            }
+
+            auto route = topology->route(i, j);
+            auto chunk = chunk_pool->create_chunk(job.message_size, chunk_id++, route, chunk_arrived_callback, nullptr);
+            topology->send(std::move(chunk));
+        }
+    }
+
+    // run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    const auto end_time = std::chrono::steady_clock::now();
+
+    auto result = SweepResult();
+    result.npus_count = npus_count;
+    result.devices_count = topology->get_devices_count();
+    result.finish_time = event_queue->get_current_time();
+    result.events_count = event_queue->get_scheduled_events_count();
+    result.peak_chunks_count = chunk_pool->get_peak_live_chunks_count();
+    result.wall_time_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    return result;
+}
+
+/**
+ * Parse the event queue backend name.
+ *
+ * @param name "list", "calendar", or "heap"
+ * @return parsed EventQueueType
+ */
+EventQueueType parse_event_queue_type(const std::string& name) noexcept {
+    if (name == "list") {
+        return EventQueueType::List;
+    }
+
+    if (name == "calendar") {
+        return EventQueueType::Calendar;
+    }
+
+    if (name == "heap") {
+        return EventQueueType::Heap;
+    }
+
+    std::cerr << "[Error] (network/analytical/congestion_aware) " << "event queue " << name << " not supported"
+              << std::endl;
+    std::exit(-1);
+}
+
+/**
+ * Escape a string to be written as a JSON string value.
+ *
+ * @param value string to escape
+ * @return escaped string
+ */
+std::string escape_json(const std::string& value) noexcept {
+    auto escaped = std::string();
+    for (const auto c : value) {
+        if (c == '"' || c == '\\') {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(c);
+    }
+    return escaped;
+}
+
+/**
+ * Write the sweep results, in CSV or JSONL format depending on the file extension.
+ *
+ * @param output_path path of the output file
+ * @param jobs simulations of the sweep
+ * @param results result per each simulation
+ */
+void write_results(const std::string& output_path,
+                   const std::vector<SweepJob>& jobs,
+                   const std::vector<SweepResult>& results) noexcept {
+    auto output = std::ofstream(output_path);
+    if (!output.is_open()) {
+        std::cerr << "[Error] (network/analytical/congestion_aware) " << "cannot open " << output_path << std::endl;
+        std::exit(-1);
+    }
+
+    const auto jsonl = output_path.size() >= 6 && output_path.substr(output_path.size() - 6) == ".jsonl";
+
+    if (!jsonl) {
+        output << "network,message_size,npus_count,devices_count,finish_time_ns,events_count,peak_chunks_count,wall_time_ms"
+               << '\n';
+    }
+
+    for (size_t i = 0; i < jobs.size(); i++) {
+        const auto& job = jobs[i];
+        const auto& result = results[i];
+
+        if (jsonl) {
+            output << "{\"network\": \"" << escape_json(job.network_path) << "\", "
+                   << "\"message_size\": " << job.message_size << ", "
+                   << "\"npus_count\": " << result.npus_count << ", "
+                   << "\"devices_count\": " << result.devices_count << ", "
+                   << "\"finish_time_ns\": " << result.finish_time << ", "
+                   << "\"events_count\": " << result.events_count << ", "
+                   << "\"peak_chunks_count\": " << result.peak_chunks_count << ", "
+                   << "\"wall_time_ms\": " << result.wall_time_ms << "}" << '\n';
+        } else {
+            output << job.network_path << "," << job.message_size << "," << result.npus_count << ","
+                   << result.devices_count << "," << result.finish_time << "," << result.events_count << ","
+                   << result.peak_chunks_count << "," << result.wall_time_ms << '\n';
+        }
+    }
+}
+
+void print_usage() noexcept {
+    std::cout << "Usage: Analytical_Congestion_Aware_Sweep [options]" << std::endl;
+    std::cout << "  --network <path>        network config file (repeatable)" << std::endl;
+    std::cout << "  --size <bytes>          message size (repeatable)" << std::endl;
+    std::cout << "  --threads <count>       number of worker threads (default: hardware concurrency)" << std::endl;
+    std::cout << "  --event-queue <type>    list, calendar, or heap (default: list)" << std::endl;
+    std::cout << "  --output <path>         .csv or .jsonl result file (default: sweep.csv)" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    // sweep settings
+    auto network_paths = std::vector<std::string>();
+    auto message_sizes = std::vector<ChunkSize>();
+    auto threads_count = static_cast<int>(std::thread::hardware_concurrency());
+    auto event_queue_type = EventQueueType::List;
+    auto output_path = std::string("sweep.csv");
+
+    // parse arguments
+    for (auto i = 1; i < argc; i++) {
+        const auto option = std::string(argv[i]);
+        if (option == "--help" || option == "-h") {
+            print_usage();
+            return 0;
+        }
+
+        if (i + 1 >= argc) {
+            std::cerr << "[Error] (network/analytical/congestion_aware) " << "missing value for " << option
+                      << std::endl;
+            print_usage();
+            return -1;
+        }
+
+        const auto value = std::string(argv[++i]);
+        if (option == "--network") {
+            network_paths.push_back(value);
+        } else if (option == "--size") {
+            message_sizes.push_back(std::stoull(value));
+        } else if (option == "--threads") {
+            threads_count = std::stoi(value);
+        } else if (option == "--event-queue") {
+            event_queue_type = parse_event_queue_type(value);
+        } else if (option == "--output") {
+            output_path = value;
+        } else {
+            std::cerr << "[Error] (network/analytical/congestion_aware) " << "unknown option " << option << std::endl;
+            print_usage();
+            return -1;
+        }
+    }
+
+    if (network_paths.empty() || message_sizes.empty()) {
+        print_usage();
+        return -1;
+    }
+    if (threads_count <= 0) {
+        threads_count = 1;
+    }
+
+    // enumerate simulations
+    auto jobs = std::vector<SweepJob>();
+    for (const auto& network_path : network_paths) {
+        for (const auto message_size : message_sizes) {
+            jobs.push_back({network_path, message_size});
+        }
+    }
+
+    // run simulations
+    auto results = std::vector<SweepResult>(jobs.size());
+    auto finished_jobs_count = std::atomic<size_t>(0);
+    auto print_mutex = std::mutex();
+    auto thread_pool = WorkStealingThreadPool(threads_count);
+    thread_pool.run(jobs.size(), [&](const size_t job_index) {
+        results[job_index] = run_simulation(jobs[job_index], event_queue_type);
+
+        const auto finished = ++finished_jobs_count;
+        const auto lock = std::lock_guard<std::mutex>(print_mutex);
+        std::cout << "[" << finished << "/" << jobs.size() << "] " << jobs[job_index].network_path
+                  << " (message size: " << jobs[job_index].message_size
+                  << " B) finished at time: " << results[job_index].finish_time << " ns" << std::endl;
+    });
+
+    // dump results
+    write_results(output_path, jobs, results);
+    std::cout << "Results written to: " << output_path << std::endl;
+
+    return 0;
+}
@@ -13,6 +13,7 @@ LICENSE file in the root directory of this source tree.
 #include "congestion_aware/Mesh1D.h"
 #include "congestion_aware/VirtualSwitch.h"
 #include "congestion_aware/SpinalSwitch.h"
+#include <cassert>
 #include <cstdlib>
 #include <iostream>
 
@@ -20,7 +21,14 @@ using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
 
 std::shared_ptr<Topology> NetworkAnalyticalCongestionAware::construct_topology(
-    const NetworkParser& network_parser) noexcept {
+    const NetworkParser& network_parser,
+    std::shared_ptr<SimulationContext> context) noexcept {
+    // fall back to the default context
+    if (context == nullptr) {
+        context = Topology::get_default_context();
+    }
+    assert(context != nullptr);
+
     // get network_parser info
     const auto dims_count = network_parser.get_dims_count();
     const auto topologies_per_dim = network_parser.get_topologies_per_dim();
@@ -36,75 +44,80 @@ std::shared_ptr<Topology> NetworkAnalyticalCongestionAware::construct_topology(
     const auto bandwidth = bandwidths_per_dim[0];
     const auto latency = latencies_per_dim[0];
 
+    auto topology = std::shared_ptr<Topology>();
     switch (topology_type) {
     case TopologyBuildingBlock::Ring:
-        return std::make_shared<Ring>(npus_count, bandwidth, latency, 0);
+        topology = std::make_shared<Ring>(npus_count, bandwidth, latency, false, 0, context);
+        break;
     case TopologyBuildingBlock::Switch:
-        return std::make_shared<Switch>(npus_count, bandwidth, latency, 0);
+        topology = std::make_shared<Switch>(npus_count, bandwidth, latency, 0, context);
+        break;
     case TopologyBuildingBlock::FullyConnected:
-        return std::make_shared<FullyConnected>(npus_count, bandwidth, latency, 0);
+        topology = std::make_shared<FullyConnected>(npus_count, bandwidth, latency, 0, context);
+        break;
     case TopologyBuildingBlock::Mesh2D:
-        return std::make_shared<Mesh2D>(npus_count, bandwidth, latency, 0);
+        topology = std::make_shared<Mesh2D>(npus_count, bandwidth, latency, 0, context);
+        break;
     case TopologyBuildingBlock::Tree:
-        return std::make_shared<Tree>(npus_count, bandwidth, latency, 0);
+        topology = std::make_shared<Tree>(npus_count, bandwidth, latency, 0, context);
+        break;
     default:
         // shouldn't reaach here
         std::cerr << "[Error] (network/analytical/congestion_aware) " << "not supported basic-topology" << std::endl;
         std::exit(-1);
     }
-    }
 
-    const auto multi_dim_topology = std::make_shared<MultiDimTopology>();
-
-    multi_dim_topology->real_swtich_count = npus_counts_per_dim[dims_count-1];
-    multi_dim_topology->npu_counts = 1;
-    for (auto dim = 0; dim < dims_count; dim++) {
-        multi_dim_topology->npu_counts *= npus_counts_per_dim[dim];
+    topology->set_packet_size(network_parser.get_packet_size());
+    return topology;
     }
 
-    auto current_device_count = 0;
-    for (auto dim = 0; dim < dims_count; dim++) {
+    const auto multi_dim_topology = std::make_shared<MultiDimTopology>(context);
 
+    // create and append dims, replicated per each group of NPUs by the multi-dim topology
+    for (auto dim = 0; dim < dims_count; dim++) {
+        // retrieve info
         const auto topology_type = topologies_per_dim[dim];
         const auto npus_count = npus_counts_per_dim[dim];
         const auto bandwidth = bandwidths_per_dim[dim];
         const auto latency = latencies_per_dim[dim];
-        
-        // calculate the number of topo instances in the current dimension
-        auto nodes_count = 1;
-        for(auto i = dim+1; i < dims_count; i++) {
-            nodes_count *= npus_counts_per_dim[i];
-        }
 
-        std::vector<std::unique_ptr<BasicTopology>> subnet_topologies;
-        for (auto i = 0; i<nodes_count; i++) {
-            // create a subnet topology
-            std::unique_ptr<BasicTopology> subnet_topology;
-            switch (topology_type) {
-            case TopologyBuildingBlock::Mesh1D:
-                subnet_topology = std::make_unique<Mesh1D>(npus_count, bandwidth, latency, current_device_count);
-                break;
-            case TopologyBuildingBlock::VirtualSwitch:
-                subnet_topology = std::make_unique<VirtualSwitch>(npus_count, bandwidth, latency, current_device_count);
-                break;
-            case TopologyBuildingBlock::SpinalSwitch:
-                subnet_topology = std::make_unique<SpinalSwitch>(npus_count, bandwidth, latency, current_device_count);
-                break;
-            default:
-                // shouldn't reach here
-                std::cerr << "[Error] (network/analytical/congestion_aware) " << "not supported basic-topology" << std::endl;
-                std::exit(-1);
-            }
-            current_device_count += subnet_topology->get_devices_count();
-            subnet_topologies.push_back(std::move(subnet_topology));
+        // create a network dim
+        std::unique_ptr<BasicTopology> dim_topology;
+        switch (topology_type) {
+        case TopologyBuildingBlock::Ring:
+            dim_topology = std::make_unique<Ring>(npus_count, bandwidth, latency, false, 0, context);
+            break;
+        case TopologyBuildingBlock::Switch:
+            dim_topology = std::make_unique<Switch>(npus_count, bandwidth, latency, 0, context);
+            break;
+        case TopologyBuildingBlock::FullyConnected:
+            dim_topology = std::make_unique<FullyConnected>(npus_count, bandwidth, latency, 0, context);
+            break;
+        case TopologyBuildingBlock::Mesh1D:
+            dim_topology = std::make_unique<Mesh1D>(npus_count, bandwidth, latency, 0, context);
+            break;
+        case TopologyBuildingBlock::Mesh2D:
+            dim_topology = std::make_unique<Mesh2D>(npus_count, bandwidth, latency, 0, context);
+            break;
+        case TopologyBuildingBlock::VirtualSwitch:
+            dim_topology = std::make_unique<VirtualSwitch>(npus_count, bandwidth, latency, 0, context);
+            break;
+        case TopologyBuildingBlock::SpinalSwitch:
+            dim_topology = std::make_unique<SpinalSwitch>(npus_count, bandwidth, latency, 0, context);
+            break;
+        default:
+            // shouldn't reach here
+            std::cerr << "[Error] (network/analytical/congestion_aware) " << "not supported basic-topology" << std::endl;
+            std::exit(-1);
         }
-        multi_dim_topology->append_dimension(std::move(subnet_topologies));
-    }
 
-    // Connect the dimensions
-    for (auto dim = 0; dim < dims_count - 1; dim++) {
-        multi_dim_topology->connect_dimensions(dim, dim + 1);
+        // append network dimension
+        multi_dim_topology->append_dimension(std::move(dim_topology));
     }
 
+    // instantiate devices and connect the dimensions
+    multi_dim_topology->connect_dimensions();
+
+    multi_dim_topology->set_packet_size(network_parser.get_packet_size());
     return multi_dim_topology;
 }
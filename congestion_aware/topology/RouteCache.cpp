@@ -0,0 +1,229 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/RouteCache.h"
+#include "congestion_aware/Device.h"
+#include "congestion_aware/Topology.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <thread>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+RouteCache::RouteCache(const Topology* const topology, const size_t memory_limit, const int threads_count) noexcept
+    : topology(topology),
+      memory_limit(memory_limit),
+      threads_count(threads_count),
+      npus_count(0),
+      initialized(false),
+      table_built(false),
+      table_ports_resolved(false),
+      recent_routes_memory(0) {
+    assert(topology != nullptr);
+    assert(threads_count > 0);
+}
+
+Route RouteCache::route(const DeviceId src, const DeviceId dest) noexcept {
+    // build the cache on the first lookup, once the topology is fully constructed
+    if (!initialized) {
+        initialize();
+    }
+
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    const auto pair = static_cast<uint64_t>(src) * npus_count + dest;
+
+    // look up the route table
+    if (table_built) {
+        // ports are resolved once the links are bound to the LinkStore (i.e., by the first send)
+        if (!table_ports_resolved && topology->link_store != nullptr) {
+            resolve_table_ports();
+        }
+
+        const auto* const route_begin = route_devices.data() + offsets[pair];
+        const auto* const route_end = route_devices.data() + offsets[pair + 1];
+        const auto* const route_ports_begin = table_ports_resolved ? route_ports.data() + offsets[pair] : nullptr;
+        return to_route(route_begin, route_end, route_ports_begin);
+    }
+
+    // look up the least-recently-used cache
+    const auto cached_route = recent_routes_index.find(pair);
+    if (cached_route != recent_routes_index.end()) {
+        // mark as the most recently used
+        recent_routes.splice(recent_routes.begin(), recent_routes, cached_route->second);
+        const auto& cached_route_devices = cached_route->second->second;
+        return to_route(cached_route_devices.data(), cached_route_devices.data() + cached_route_devices.size(),
+                        nullptr);
+    }
+
+    // compute and cache the route
+    auto new_route_devices = std::vector<DeviceId>();
+    compute_route_devices(src, dest, new_route_devices);
+    recent_routes_memory += get_memory_usage(new_route_devices);
+    recent_routes.emplace_front(pair, std::move(new_route_devices));
+    recent_routes_index[pair] = recent_routes.begin();
+
+    // evict the least recently used routes
+    while (recent_routes_memory > memory_limit && recent_routes.size() > 1) {
+        const auto& evicted_route = recent_routes.back();
+        recent_routes_memory -= get_memory_usage(evicted_route.second);
+        recent_routes_index.erase(evicted_route.first);
+        recent_routes.pop_back();
+    }
+
+    const auto& cached_route_devices = recent_routes.front().second;
+    return to_route(cached_route_devices.data(), cached_route_devices.data() + cached_route_devices.size(), nullptr);
+}
+
+bool RouteCache::is_table_built() const noexcept {
+    return table_built;
+}
+
+size_t RouteCache::get_memory_usage() const noexcept {
+    if (table_built) {
+        return route_devices.size() * sizeof(DeviceId) + route_ports.size() * sizeof(int32_t) +
+               offsets.size() * sizeof(uint64_t);
+    }
+    return recent_routes_memory;
+}
+
+void RouteCache::initialize() noexcept {
+    assert(!initialized);
+
+    // index devices by id
+    for (const auto& device : topology->get_devices()) {
+        const auto id = device->get_id();
+        if (id >= static_cast<DeviceId>(devices.size())) {
+            devices.resize(id + 1);
+        }
+        devices[id] = device;
+    }
+
+    npus_count = topology->get_npus_count();
+    table_built = build_table();
+    initialized = true;
+}
+
+bool RouteCache::build_table() noexcept {
+    const auto pairs_count = static_cast<uint64_t>(npus_count) * npus_count;
+
+    // offsets alone may not fit
+    const auto offsets_memory = (pairs_count + 1) * sizeof(uint64_t);
+    if (offsets_memory > memory_limit) {
+        return false;
+    }
+
+    // run a pass over the rows, each row of src on a worker
+    const auto workers_count = std::max(1, std::min(threads_count, npus_count));
+    const auto run_workers = [workers_count](const auto& process_rows) noexcept {
+        auto workers = std::vector<std::thread>();
+        for (auto worker = 1; worker < workers_count; worker++) {
+            workers.emplace_back(process_rows, worker, workers_count);
+        }
+        process_rows(0, workers_count);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    };
+
+    // first pass: count the device ids of every route into the offsets, without keeping the routes,
+    // stopping once the table is known to exceed the memory limit
+    offsets.assign(pairs_count + 1, 0);
+    auto memory_usage = std::atomic<size_t>(offsets_memory);
+    auto exceeded = std::atomic<bool>(false);
+    run_workers([&](const int worker, const int workers_count) noexcept {
+        auto route = std::vector<DeviceId>();
+        for (auto src = worker; src < npus_count && !exceeded.load(std::memory_order_relaxed); src += workers_count) {
+            auto row_length = size_t(0);
+            for (auto dest = 0; dest < npus_count; dest++) {
+                if (src == dest) {
+                    continue;
+                }
+                route.clear();
+                compute_route_devices(src, dest, route);
+                offsets[static_cast<uint64_t>(src) * npus_count + dest + 1] = route.size();
+                row_length += route.size();
+            }
+
+            const auto row_memory = row_length * (sizeof(DeviceId) + sizeof(int32_t));
+            if (memory_usage.fetch_add(row_memory, std::memory_order_relaxed) + row_memory > memory_limit) {
+                exceeded.store(true, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    if (exceeded.load()) {
+        offsets = std::vector<uint64_t>();
+        return false;
+    }
+
+    // route lengths into offsets
+    for (uint64_t pair = 0; pair < pairs_count; pair++) {
+        offsets[pair + 1] += offsets[pair];
+    }
+
+    // second pass: compute the routes again, straight into their place in the table
+    route_devices.resize(offsets[pairs_count]);
+    route_ports.assign(offsets[pairs_count], -1);
+    run_workers([&](const int worker, const int workers_count) noexcept {
+        auto route = std::vector<DeviceId>();
+        for (auto src = worker; src < npus_count; src += workers_count) {
+            for (auto dest = 0; dest < npus_count; dest++) {
+                if (src == dest) {
+                    continue;
+                }
+                const auto pair = static_cast<uint64_t>(src) * npus_count + dest;
+                route.clear();
+                compute_route_devices(src, dest, route);
+                assert(route.size() == offsets[pair + 1] - offsets[pair]);
+                std::copy(route.begin(), route.end(), route_devices.begin() + offsets[pair]);
+            }
+        }
+    });
+
+    return true;
+}
+
+void RouteCache::compute_route_devices(const DeviceId src,
+                                       const DeviceId dest,
+                                       std::vector<DeviceId>& route_devices) const noexcept {
+    for (const auto& device : topology->compute_route(src, dest)) {
+        route_devices.push_back(device->get_id());
+    }
+}
+
+void RouteCache::resolve_table_ports() noexcept {
+    assert(table_built);
+    assert(!table_ports_resolved);
+
+    const auto pairs_count = static_cast<uint64_t>(npus_count) * npus_count;
+    for (uint64_t pair = 0; pair < pairs_count; pair++) {
+        // the port of each device connected to the following one, none for the dest
+        for (auto i = offsets[pair]; i + 1 < offsets[pair + 1]; i++) {
+            route_ports[i] = devices[route_devices[i]]->get_port(route_devices[i + 1]);
+            assert(route_ports[i] >= 0);
+        }
+    }
+    table_ports_resolved = true;
+}
+
+Route RouteCache::to_route(const DeviceId* const begin,
+                           const DeviceId* const end,
+                           const int32_t* const ports) const noexcept {
+    auto route = Route();
+    for (const auto* id = begin; id != end; id++) {
+        route.push_back(devices[*id]);
+    }
+    if (ports != nullptr) {
+        route.set_ports(ports);
+    }
+    return route;
+}
+
+size_t RouteCache::get_memory_usage(const std::vector<DeviceId>& route_devices) noexcept {
+    // route itself, list node, and hash map node
+    return sizeof(CachedRoute) + 4 * sizeof(void*) + route_devices.capacity() * sizeof(DeviceId);
+}
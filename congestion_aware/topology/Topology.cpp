@@ -9,17 +9,60 @@ LICENSE file in the root directory of this source tree.
 
 using namespace NetworkAnalyticalCongestionAware;
 
-void Topology::set_event_queue(std::shared_ptr<EventQueue> event_queue) noexcept {
+namespace {
+
+/// context of topologies constructed without an explicit one
+std::shared_ptr<SimulationContext> default_context;
+
+}  // namespace
+
+void Topology::set_event_queue(std::shared_ptr<EventQueue> event_queue,
+                               std::shared_ptr<TraceWriter> trace_writer) noexcept {
     assert(event_queue != nullptr);
 
-    // pass the given event_queue to Link
-    Link::set_event_queue(std::move(event_queue));
+    // create the default context on the given event_queue
+    default_context = std::make_shared<SimulationContext>(std::move(event_queue), std::move(trace_writer));
+}
+
+std::shared_ptr<SimulationContext> Topology::get_default_context() noexcept {
+    return default_context;
 }
 
-Topology::Topology(int base_id) noexcept : npus_count(-1), devices_count(-1), dims_count(-1), base_id(base_id) {
+Topology::Topology(int base_id, std::shared_ptr<SimulationContext> context) noexcept
+    : npus_count(-1),
+      devices_count(-1),
+      dims_count(-1),
+      base_id(base_id),
+      context(std::move(context)),
+      packet_size(0),
+      virtual_channels_count(1),
+      virtual_channel_arbitration(VirtualChannelArbitration::RoundRobin),
+      utilization_window(0) {
+    assert(this->context != nullptr);
+
     npus_count_per_dim = {};
 }
 
+Route Topology::route(const DeviceId src, const DeviceId dest) const noexcept {
+    if (route_cache != nullptr) {
+        return route_cache->route(src, dest);
+    }
+
+    return compute_route(src, dest);
+}
+
+void Topology::enable_route_cache(const size_t memory_limit, const int threads_count) noexcept {
+    route_cache = std::make_unique<RouteCache>(this, memory_limit, threads_count);
+}
+
+const RouteCache* Topology::get_route_cache() const noexcept {
+    return route_cache.get();
+}
+
+std::shared_ptr<SimulationContext> Topology::get_simulation_context() const noexcept {
+    return context;
+}
+
 int Topology::get_devices_count() const noexcept {
     assert(devices_count >= 0);
     assert(npus_count >= 0);
@@ -29,12 +72,8 @@ int Topology::get_devices_count() const noexcept {
 }
 
 bool Topology::contains_device(DeviceId device_id) const noexcept {
-    for (auto device : devices) {
-        if (device->get_id() == device_id) {
-            return true;
-        }
-    }
-    return false;
+    // device ids of a topology are contiguous, starting from base_id
+    return base_id <= device_id && device_id < base_id + static_cast<DeviceId>(devices.size());
 }
 
 int Topology::get_npus_count() const noexcept {
@@ -56,12 +95,14 @@ std::vector<std::shared_ptr<Device>> Topology::get_devices() const noexcept {
 }
 
 std::shared_ptr<Device> Topology::get_device(DeviceId device_id) const noexcept {
-    for (auto device : devices) {
-        if (device->get_id() == device_id) {
-            return device;
-        }
+    if (!contains_device(device_id)) {
+        return nullptr;
     }
-    return nullptr;    
+
+    // device ids of a topology are contiguous, starting from base_id
+    const auto& device = devices[device_id - base_id];
+    assert(device->get_id() == device_id);
+    return device;
 }
 
 std::vector<int> Topology::get_npus_count_per_dim() const noexcept {
@@ -76,15 +117,127 @@ std::vector<Bandwidth> Topology::get_bandwidth_per_dim() const noexcept {
     return bandwidth_per_dim;
 }
 
+void Topology::set_packet_size(const ChunkSize packet_size) noexcept {
+    this->packet_size = packet_size;
+}
+
+ChunkSize Topology::get_packet_size() const noexcept {
+    return packet_size;
+}
+
+void Topology::set_virtual_channels(const int virtual_channels_count,
+                                    const VirtualChannelArbitration arbitration) noexcept {
+    assert(virtual_channels_count > 0);
+
+    this->virtual_channels_count = virtual_channels_count;
+    virtual_channel_arbitration = arbitration;
+
+    // links are configured once instantiated, if not yet
+    if (link_store != nullptr) {
+        configure_links();
+    }
+}
+
+void Topology::set_utilization_window(const EventTime utilization_window) noexcept {
+    this->utilization_window = utilization_window;
+
+    // links are configured once instantiated, if not yet
+    if (link_store != nullptr) {
+        configure_links();
+    }
+}
+
+LinkTelemetry Topology::get_link_telemetry(const DeviceId src, const DeviceId dest) const noexcept {
+    const auto device = get_device(src);
+
+    // links are instantiated by the first send
+    if (device == nullptr || link_store == nullptr) {
+        return LinkTelemetry();
+    }
+
+    const auto port = device->get_port(dest);
+    if (port < 0) {
+        return LinkTelemetry();
+    }
+
+    return device->get_link(port)->get_telemetry();
+}
+
+void Topology::dump_link_telemetry(std::ostream& output) const noexcept {
+    if constexpr (!link_telemetry_enabled) {
+        return;
+    }
+
+    // links are instantiated by the first send
+    if (link_store == nullptr) {
+        return;
+    }
+
+    // restore the format of the stream afterwards
+    const auto flags = output.flags();
+    const auto precision = output.precision(4);
+    output << std::fixed;
+
+    const auto current_time = context->get_current_time();
+    output << "src dest carried_bytes busy_time utilization stalls peak_pending average_pending" << std::endl;
+    for (const auto& device : devices) {
+        for (auto port = 0; port < device->get_ports_count(); port++) {
+            const auto telemetry = device->get_link(port)->get_telemetry();
+            if (telemetry.carried_bytes == 0) {
+                continue;
+            }
+
+            const auto utilization =
+                (current_time > 0) ? static_cast<double>(telemetry.busy_time) / current_time : 0.0;
+            output << device->get_id() << " " << device->get_neighbor(port) << " " << telemetry.carried_bytes << " "
+                   << telemetry.busy_time << " " << utilization << " " << telemetry.stalls_count << " "
+                   << telemetry.peak_pending_chunks_count << " " << telemetry.average_pending_chunks_count << std::endl;
+        }
+    }
+
+    output.flags(flags);
+    output.precision(precision);
+}
+
+void Topology::build_link_store() noexcept {
+    if (link_store == nullptr) {
+        link_store = std::make_unique<LinkStore>(devices);
+        configure_links();
+    }
+}
+
+void Topology::configure_links() noexcept {
+    assert(link_store != nullptr);
+
+    for (size_t i = 0; i < link_store->get_links_count(); i++) {
+        auto& link = link_store->get_link(i);
+        link.set_virtual_channels(virtual_channels_count, virtual_channel_arbitration);
+        link.set_utilization_window(utilization_window);
+    }
+}
+
 void Topology::send(std::unique_ptr<Chunk> chunk) noexcept {
     assert(chunk != nullptr);
 
+    // the topology is fully constructed by the first send
+    if (link_store == nullptr) {
+        build_link_store();
+    }
+
     // get src npu node_id
     const auto src = chunk->current_device()->get_id();
 
     // assert src is valid
     assert(0 <= src && src < devices_count);
 
+    // bind the chunk to the simulation of its source device
+    chunk->set_simulation_context(devices[src]->get_simulation_context());
+
+    // split the chunk into packets, if configured
+    if (packet_size > 0) {
+        chunk->set_packet_size(packet_size);
+    }
+
     // initiate transmission from src
     devices[src]->send(std::move(chunk));
 }
@@ -115,6 +268,6 @@ void Topology::connect(const DeviceId src,
 void Topology::instantiate_devices() noexcept {
     // instantiate all devices
     for (auto i = 0; i < devices_count; i++) {
-        devices.push_back(std::make_shared<Device>(this->base_id + i, this->base_id));
+        devices.push_back(std::make_shared<Device>(this->base_id + i, context, this->base_id));
     }
 }
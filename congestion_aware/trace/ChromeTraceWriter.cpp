@@ -0,0 +1,119 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/ChromeTraceWriter.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Device.h"
+#include "congestion_aware/Topology.h"
+#include <cassert>
+#include <iostream>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+ChromeTraceWriter::ChromeTraceWriter(const std::string& path, Topology& topology) noexcept : first_event(true) {
+    file.open(path);
+    if (!file.is_open()) {
+        std::cerr << "[Error] (network/analytical/congestion_aware) " << "cannot open " << path << std::endl;
+        std::exit(-1);
+    }
+
+    file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+    // name the processes
+    begin_event();
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << links_pid << ",\"args\":{\"name\":\"Links\"}}";
+    begin_event();
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << chunks_pid << ",\"args\":{\"name\":\"Chunks\"}}";
+
+    // name a track per each link, in (device, port) order
+    topology.build_link_store();
+    for (const auto& device : topology.get_devices()) {
+        for (auto port = 0; port < device->get_ports_count(); port++) {
+            const auto track = static_cast<int>(link_tracks.size());
+            link_tracks[device->get_link(port)] = track;
+
+            begin_event();
+            file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << links_pid << ",\"tid\":" << track
+                 << ",\"args\":{\"name\":\"" << device->get_id() << " -> " << device->get_neighbor(port) << "\"}}";
+        }
+    }
+}
+
+ChromeTraceWriter::~ChromeTraceWriter() noexcept {
+    file << "\n]}\n";
+}
+
+void ChromeTraceWriter::write_transmission(const Link* const link,
+                                           const Chunk& chunk,
+                                           const EventTime begin_time,
+                                           const EventTime end_time) noexcept {
+    assert(link != nullptr);
+    assert(begin_time <= end_time);
+
+    const auto link_track = link_tracks.find(link);
+    assert(link_track != link_tracks.end());
+
+    begin_event();
+    file << "{\"name\":\"" << chunk.src_device_id << " -> " << chunk.dst_device_id
+         << "\",\"cat\":\"transmission\",\"ph\":\"X\",\"pid\":" << links_pid << ",\"tid\":" << link_track->second
+         << ",\"ts\":";
+    write_time(begin_time);
+    file << ",\"dur\":";
+    write_time(end_time - begin_time);
+    file << ",\"args\":{\"size\":" << chunk.get_size() << "}}";
+}
+
+void ChromeTraceWriter::write_stall(const Chunk& chunk, const EventTime begin_time, const EventTime end_time) noexcept {
+    assert(begin_time <= end_time);
+
+    // nested into the span of the chunk, sharing its id
+    for (const auto& [phase, time] : {std::make_pair('b', begin_time), std::make_pair('e', end_time)}) {
+        begin_event();
+        file << "{\"name\":\"stall\",\"cat\":\"chunk\",\"ph\":\"" << phase << "\",\"pid\":" << chunks_pid
+             << ",\"id\":\"" << static_cast<const void*>(&chunk) << "\",\"ts\":";
+        write_time(time);
+        file << "}";
+    }
+}
+
+void ChromeTraceWriter::write_chunk(const Chunk& chunk,
+                                    const EventTime sent_time,
+                                    const EventTime arrival_time) noexcept {
+    assert(sent_time <= arrival_time);
+
+    // chunks in flight are identified by their addresses
+    begin_event();
+    file << "{\"name\":\"chunk " << chunk.src_device_id << " -> " << chunk.dst_device_id
+         << "\",\"cat\":\"chunk\",\"ph\":\"b\",\"pid\":" << chunks_pid << ",\"id\":\""
+         << static_cast<const void*>(&chunk) << "\",\"ts\":";
+    write_time(sent_time);
+    file << ",\"args\":{\"size\":" << chunk.get_size() << ",\"stall_count\":" << chunk.stall_count
+         << ",\"stall_time\":" << chunk.stall_times << "}}";
+
+    begin_event();
+    file << "{\"name\":\"chunk " << chunk.src_device_id << " -> " << chunk.dst_device_id
+         << "\",\"cat\":\"chunk\",\"ph\":\"e\",\"pid\":" << chunks_pid << ",\"id\":\""
+         << static_cast<const void*>(&chunk) << "\",\"ts\":";
+    write_time(arrival_time);
+    file << "}";
+}
+
+void ChromeTraceWriter::flush() noexcept {
+    file.flush();
+}
+
+void ChromeTraceWriter::begin_event() noexcept {
+    if (!first_event) {
+        file << ",\n";
+    }
+    first_event = false;
+}
+
+void ChromeTraceWriter::write_time(const EventTime time) noexcept {
+    // integer and fractional parts of us, keeping ns precision
+    const auto fraction = time % 1'000;
+    file << time / 1'000 << '.' << static_cast<char>('0' + fraction / 100) << static_cast<char>('0' + fraction / 10 % 10)
+         << static_cast<char>('0' + fraction % 10);
+}
@@ -0,0 +1,37 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/TraceReader.h"
+#include <cstring>
+#include <iostream>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+TraceReader::TraceReader(const std::string& path) noexcept {
+    file.open(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[Error] (network/analytical/congestion_aware) " << "cannot open " << path << std::endl;
+        std::exit(-1);
+    }
+
+    // validate the header
+    auto header = TraceHeader();
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, trace_magic, sizeof(header.magic)) != 0) {
+        std::cerr << "[Error] (network/analytical/congestion_aware) " << path << " is not a trace file" << std::endl;
+        std::exit(-1);
+    }
+
+    if (header.version != trace_version || header.record_size != sizeof(TraceRecord)) {
+        std::cerr << "[Error] (network/analytical/congestion_aware) " << "trace version " << header.version
+                  << " not supported" << std::endl;
+        std::exit(-1);
+    }
+}
+
+bool TraceReader::read(TraceRecord& record) noexcept {
+    file.read(reinterpret_cast<char*>(&record), sizeof(record));
+    return static_cast<bool>(file);
+}
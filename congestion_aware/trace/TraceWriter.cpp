@@ -0,0 +1,116 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/TraceWriter.h"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+TraceWriter::TraceWriter(const std::string& path,
+                         const bool background_writer,
+                         const size_t buffer_records_count) noexcept
+    : buffer_records_count(buffer_records_count),
+      flushed_records_count(0),
+      stopping(false) {
+    assert(buffer_records_count > 0);
+
+    file.open(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[Error] (network/analytical/congestion_aware) " << "cannot open " << path << std::endl;
+        std::exit(-1);
+    }
+
+    // write the header
+    auto header = TraceHeader();
+    std::memcpy(header.magic, trace_magic, sizeof(header.magic));
+    header.version = trace_version;
+    header.record_size = sizeof(TraceRecord);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // buffers are allocated once
+    front_buffer.reserve(buffer_records_count);
+    back_buffer.reserve(buffer_records_count);
+
+    if (background_writer) {
+        writer = std::thread(&TraceWriter::run_writer, this);
+    }
+}
+
+TraceWriter::~TraceWriter() noexcept {
+    flush();
+
+    // stop the writer thread
+    if (writer.joinable()) {
+        {
+            const auto lock = std::lock_guard<std::mutex>(mutex);
+            stopping = true;
+        }
+        back_buffer_changed.notify_all();
+        writer.join();
+    }
+}
+
+void TraceWriter::flush() noexcept {
+    if (!front_buffer.empty()) {
+        flush_front_buffer();
+    }
+
+    // wait for the writer thread to write the handed-over buffer
+    if (writer.joinable()) {
+        auto lock = std::unique_lock<std::mutex>(mutex);
+        back_buffer_changed.wait(lock, [this]() noexcept { return back_buffer.empty(); });
+    }
+
+    file.flush();
+}
+
+uint64_t TraceWriter::get_records_count() const noexcept {
+    return flushed_records_count + front_buffer.size();
+}
+
+void TraceWriter::flush_front_buffer() noexcept {
+    flushed_records_count += front_buffer.size();
+
+    // write in place
+    if (!writer.joinable()) {
+        write_records(front_buffer);
+        front_buffer.clear();
+        return;
+    }
+
+    // once the writer thread is done with the previous buffer, swap the buffers
+    {
+        auto lock = std::unique_lock<std::mutex>(mutex);
+        back_buffer_changed.wait(lock, [this]() noexcept { return back_buffer.empty(); });
+        std::swap(front_buffer, back_buffer);
+    }
+    back_buffer_changed.notify_all();
+}
+
+void TraceWriter::write_records(const std::vector<TraceRecord>& records) noexcept {
+    const auto size = static_cast<std::streamsize>(records.size() * sizeof(TraceRecord));
+    file.write(reinterpret_cast<const char*>(records.data()), size);
+}
+
+void TraceWriter::run_writer() noexcept {
+    auto lock = std::unique_lock<std::mutex>(mutex);
+    while (true) {
+        back_buffer_changed.wait(lock, [this]() noexcept { return !back_buffer.empty() || stopping; });
+        if (back_buffer.empty()) {
+            // stopping, with every buffer written
+            return;
+        }
+
+        // write without holding the lock, as the simulation doesn't touch a non-empty back buffer
+        lock.unlock();
+        write_records(back_buffer);
+        lock.lock();
+
+        back_buffer.clear();
+        back_buffer_changed.notify_all();
+    }
+}
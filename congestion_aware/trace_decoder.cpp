@@ -0,0 +1,29 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/TraceReader.h"
+#include <iostream>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+/**
+ * Decode a binary chunk trace (see TraceWriter) into text, one line per chunk:
+ * src, dest, sent time, arrival time, stall count, stall time, and chunk size.
+ */
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cout << "Usage: Analytical_Congestion_Aware_Trace_Decoder <trace file>" << std::endl;
+        return -1;
+    }
+
+    auto reader = TraceReader(argv[1]);
+    auto record = TraceRecord();
+    while (reader.read(record)) {
+        std::cout << record.src << " " << record.dest << " " << record.sent_time << " " << record.arrival_time << " "
+                  << record.stall_count << " " << record.stall_time << " " << record.chunk_size << '\n';
+    }
+
+    return 0;
+}
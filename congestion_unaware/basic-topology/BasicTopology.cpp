@@ -5,11 +5,108 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_unaware/BasicTopology.h"
 #include "common/NetworkFunction.h"
+#include <algorithm>
+#include <array>
 #include <cassert>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define NETWORK_BACKEND_X86_KERNELS
+#include <immintrin.h>
+#endif
+
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
 
+namespace {
+
+/**
+ * Vector kernel computing the communication delays of chunks.
+ * Kernels take the same steps as BasicTopology::compute_communication_delay, so the delays are bit-identical.
+ *
+ * @param hops_counts number of hops per each chunk
+ * @param chunk_sizes size per each chunk
+ * @param delays output, communication delay per each chunk
+ * @param count number of chunks
+ * @param latency latency of each link
+ * @param bandwidth_Bpns bandwidth in B/ns
+ * @return number of chunks processed, the remainder is left to the scalar loop
+ */
+using CommunicationDelaysKernel = size_t (*)(const int* hops_counts,
+                                             const ChunkSize* chunk_sizes,
+                                             EventTime* delays,
+                                             size_t count,
+                                             Latency latency,
+                                             Bandwidth bandwidth_Bpns);
+
+#ifdef NETWORK_BACKEND_X86_KERNELS
+__attribute__((target("avx512f,avx512dq"))) size_t compute_communication_delays_avx512(
+    const int* const hops_counts,
+    const ChunkSize* const chunk_sizes,
+    EventTime* const delays,
+    const size_t count,
+    const Latency latency,
+    const Bandwidth bandwidth_Bpns) {
+    auto i = size_t(0);
+    const auto latency_vector = _mm512_set1_pd(latency);
+    const auto bandwidth_vector = _mm512_set1_pd(bandwidth_Bpns);
+    for (; i + 8 <= count; i += 8) {
+        const auto hops = _mm512_cvtepi32_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hops_counts + i)));
+        const auto sizes = _mm512_cvtepu64_pd(_mm512_loadu_si512(chunk_sizes + i));
+        const auto link_delay = _mm512_mul_pd(hops, latency_vector);
+        const auto serialization_delay = _mm512_div_pd(sizes, bandwidth_vector);
+        const auto comms_delay = _mm512_add_pd(link_delay, serialization_delay);
+        _mm512_storeu_si512(delays + i, _mm512_cvttpd_epu64(comms_delay));
+    }
+    return i;
+}
+
+// AVX2 has no conversions between 64-bit integers and doubles: they go through the 2^52 exponent trick
+__attribute__((target("avx2"))) size_t compute_communication_delays_avx2(const int* const hops_counts,
+                                                                         const ChunkSize* const chunk_sizes,
+                                                                         EventTime* const delays,
+                                                                         const size_t count,
+                                                                         const Latency latency,
+                                                                         const Bandwidth bandwidth_Bpns) {
+    auto i = size_t(0);
+    const auto latency_vector = _mm256_set1_pd(latency);
+    const auto bandwidth_vector = _mm256_set1_pd(bandwidth_Bpns);
+    const auto magic = _mm256_set1_pd(4503599627370496.0);  // 2^52
+    const auto magic_bits = _mm256_castpd_si256(magic);
+    for (; i + 4 <= count; i += 4) {
+        const auto hops = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hops_counts + i)));
+        const auto size_bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk_sizes + i));
+        const auto sizes = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(size_bits, magic_bits)), magic);
+        const auto link_delay = _mm256_mul_pd(hops, latency_vector);
+        const auto serialization_delay = _mm256_div_pd(sizes, bandwidth_vector);
+        const auto comms_delay = _mm256_add_pd(link_delay, serialization_delay);
+        const auto truncated = _mm256_round_pd(comms_delay, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        const auto delay_bits = _mm256_xor_si256(_mm256_castpd_si256(_mm256_add_pd(truncated, magic)), magic_bits);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(delays + i), delay_bits);
+    }
+    return i;
+}
+#endif
+
+/**
+ * Select the widest vector kernel the running CPU supports.
+ *
+ * @return selected kernel, nullptr if none
+ */
+CommunicationDelaysKernel select_communication_delays_kernel() noexcept {
+#ifdef NETWORK_BACKEND_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+        return compute_communication_delays_avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return compute_communication_delays_avx2;
+    }
+#endif
+    return nullptr;
+}
+
+}  // namespace
+
 BasicTopology::BasicTopology(const int npus_count, const Bandwidth bandwidth, const Latency latency) noexcept
     : latency(latency),
       basic_topology_type(TopologyBuildingBlock::Undefined),
@@ -38,6 +135,13 @@ EventTime BasicTopology::send(const DeviceId src, const DeviceId dest, const Chu
     assert(src != dest);
     assert(chunk_size > 0);
 
+    // look up the link delay if tabulated
+    if (!link_delay_table.empty()) {
+        const auto link_delay = link_delay_table[src * npus_count + dest];
+        const auto serialization_delay = static_cast<double>(chunk_size) / bandwidth_Bpns;
+        return static_cast<EventTime>(link_delay + serialization_delay);
+    }
+
     // get hops count
     auto hops_count = compute_hops_count(src, dest);
 
@@ -45,19 +149,187 @@ EventTime BasicTopology::send(const DeviceId src, const DeviceId dest, const Chu
     return compute_communication_delay(hops_count, chunk_size);
 }
 
-EventTime BasicTopology::compute_communication_delay(const int hops_count, const ChunkSize chunk_size) const noexcept {
-    assert(hops_count > 0);
-    assert(chunk_size > 0);
+void BasicTopology::send_batch(const DeviceId* const srcs,
+                               const DeviceId* const dests,
+                               const ChunkSize* const chunk_sizes,
+                               EventTime* const delays,
+                               const size_t count) const noexcept {
+    auto hops_counts = std::array<int, batch_block_size>();
+
+    for (auto start = size_t(0); start < count; start += batch_block_size) {
+        const auto block_count = std::min(batch_block_size, count - start);
+
+        // hop counts of the block, then their delays
+        compute_hops_counts(srcs + start, dests + start, hops_counts.data(), block_count);
+        compute_communication_delays(hops_counts.data(), chunk_sizes + start, delays + start, block_count);
+    }
+}
+
+void BasicTopology::compute_hops_counts(const DeviceId* const srcs,
+                                        const DeviceId* const dests,
+                                        int* const hops_counts,
+                                        const size_t count) const noexcept {
+    for (auto i = size_t(0); i < count; i++) {
+        hops_counts[i] = compute_hops_count(srcs[i], dests[i]);
+    }
+}
+
+EventTime BasicTopology::estimate_collective(const CollectiveType type,
+                                             const CollectiveAlgorithm algorithm,
+                                             const ChunkSize size) const noexcept {
+    assert(size > 0);
+
+    // nothing to communicate among a single NPU
+    if (npus_count == 1) {
+        return 0;
+    }
+
+    // all-reduce is a reduce-scatter followed by an all-gather, except on trees
+    if (type == CollectiveType::AllReduce && algorithm != CollectiveAlgorithm::Tree) {
+        return BasicTopology::estimate_collective(CollectiveType::ReduceScatter, algorithm, size) +
+               BasicTopology::estimate_collective(CollectiveType::AllGather, algorithm, size);
+    }
+
+    // serialization delay of the whole buffer and of a piece
+    const auto n = static_cast<double>(npus_count);
+    const auto buffer_delay = static_cast<double>(size) / bandwidth_Bpns;
+    const auto piece_delay = buffer_delay / n;
+
+    // link delay between the farthest NPUs
+    const auto diameter_delay = compute_diameter_hops_count() * latency;
+
+    auto collective_delay = 0.0;
+    switch (algorithm) {
+    case CollectiveAlgorithm::Ring: {
+        const auto step_delay = compute_ring_step_hops_count() * latency;
+        if (type == CollectiveType::AllToAll) {
+            // the pieces not delivered yet travel every step: (n - 1) + (n - 2) + ... + 1 pieces
+            collective_delay = (n - 1) * step_delay + (n * (n - 1) / 2) * piece_delay;
+        } else {
+            collective_delay = (n - 1) * (step_delay + piece_delay);
+        }
+        break;
+    }
+
+    case CollectiveAlgorithm::Tree: {
+        // depth of the binary tree rooted at NPU 0, i.e., floor(log2(n))
+        auto depth = 0;
+        while ((2 << depth) <= npus_count) {
+            depth++;
+        }
 
-    // compute link delay and serialization delay
-    auto link_delay = hops_count * latency;
-    auto serialization_delay = static_cast<double>(chunk_size) / bandwidth_Bpns;
+        // reduce or broadcast: the whole buffer per level
+        const auto pass_delay = depth * (diameter_delay + buffer_delay);
 
-    // comms_delay is the summation of the two
-    auto comms_delay = link_delay + serialization_delay;
+        // gather or scatter: the pieces pipelined through the root
+        const auto pipelined_delay = depth * diameter_delay + (n - 1) * piece_delay;
+
+        switch (type) {
+        case CollectiveType::AllReduce:
+            collective_delay = 2 * pass_delay;
+            break;
+        case CollectiveType::AllGather:
+        case CollectiveType::ReduceScatter:
+            collective_delay = pass_delay + pipelined_delay;
+            break;
+        case CollectiveType::AllToAll: {
+            // the pieces crossing the root, up and down
+            const auto crossing_pieces = static_cast<double>((npus_count / 2) * ((npus_count + 1) / 2));
+            collective_delay = 2 * (depth * diameter_delay + crossing_pieces * piece_delay);
+            break;
+        }
+        }
+        break;
+    }
+
+    case CollectiveAlgorithm::HalvingDoubling: {
+        // log2(n), rounded up
+        auto steps_count = 0;
+        while ((1 << steps_count) < npus_count) {
+            steps_count++;
+        }
+
+        if (type == CollectiveType::AllToAll) {
+            // half of the buffer per exchange
+            collective_delay = steps_count * (diameter_delay + buffer_delay / 2);
+        } else {
+            // exchanges halve (or double) the data, adding up to n - 1 pieces
+            collective_delay = steps_count * diameter_delay + (n - 1) * piece_delay;
+        }
+        break;
+    }
+
+    case CollectiveAlgorithm::Direct:
+        // every other NPU gets a piece at once, serialized out of each NPU
+        collective_delay = diameter_delay + (n - 1) * piece_delay;
+        break;
+    }
+
+    // return EventTime type of collective_delay
+    return static_cast<EventTime>(collective_delay);
+}
+
+void BasicTopology::compute_communication_delays(const int* const hops_counts,
+                                                 const ChunkSize* const chunk_sizes,
+                                                 EventTime* const delays,
+                                                 const size_t count) const noexcept {
+    // the vector kernels convert through doubles, exact below 2^52
+    assert(std::all_of(chunk_sizes, chunk_sizes + count,
+                       [](const ChunkSize chunk_size) { return chunk_size < (ChunkSize(1) << 52); }));
+
+    // kernel of the running CPU, selected once
+    static const auto kernel = select_communication_delays_kernel();
+    auto i = size_t(0);
+    if (kernel != nullptr) {
+        i = kernel(hops_counts, chunk_sizes, delays, count, latency, bandwidth_Bpns);
+    }
+
+    // scalar fallback, and the remainder of the vectors
+    for (; i < count; i++) {
+        delays[i] = compute_communication_delay(hops_counts[i], chunk_sizes[i]);
+    }
+}
+
+int BasicTopology::compute_ring_step_hops_count() const noexcept {
+    assert(npus_count > 1);
+
+    // every step but the wrap-around one is as long as the first one
+    return std::max(compute_hops_count(0, 1), compute_hops_count(npus_count - 1, 0));
+}
+
+int BasicTopology::compute_diameter_hops_count() const noexcept {
+    assert(npus_count > 1);
+
+    // farthest NPUs are at either end (e.g., Mesh1D, unidirectional Ring) or halfway (bidirectional Ring)
+    return std::max(compute_hops_count(0, npus_count - 1), compute_hops_count(0, npus_count / 2));
+}
+
+Latency BasicTopology::get_latency() const noexcept {
+    return latency;
+}
+
+Bandwidth BasicTopology::get_bandwidth_Bpns() const noexcept {
+    return bandwidth_Bpns;
+}
+
+void BasicTopology::build_link_delay_table() noexcept {
+    if (npus_count > max_link_delay_table_npus_count) {
+        return;
+    }
+
+    // same link delay as compute_communication_delay, zero on the diagonal
+    link_delay_table.assign(npus_count * npus_count, 0);
+    for (auto src = 0; src < npus_count; src++) {
+        for (auto dest = 0; dest < npus_count; dest++) {
+            if (src != dest) {
+                link_delay_table[src * npus_count + dest] = compute_hops_count(src, dest) * latency;
+            }
+        }
+    }
+}
 
-    // return EventTime type of comms_delay
-    return static_cast<EventTime>(comms_delay);
+bool BasicTopology::has_link_delay_table() const noexcept {
+    return !link_delay_table.empty();
 }
 
 TopologyBuildingBlock BasicTopology::get_basic_topology_type() const noexcept {
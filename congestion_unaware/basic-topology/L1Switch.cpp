@@ -4,6 +4,7 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_unaware/Switch.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace NetworkAnalytical;
@@ -19,11 +20,10 @@ L1Switch::L1Switch(const int npus_count, const Bandwidth bandwidth, const Latenc
     basic_topology_type = TopologyBuildingBlock::L1Switch;
 }
 
-int L1Switch::compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept {
-    assert(0 <= src && src < npus_count);
-    assert(0 <= dest && dest < npus_count);
-    assert(src != dest);
-
-    // for L1Switch, hops_count is always 4 (src -> L1Switch -> L2Switch -> L1Switch -> dest)
-    return 4;
+void L1Switch::compute_hops_counts(const DeviceId* const srcs,
+                                   const DeviceId* const dests,
+                                   int* const hops_counts,
+                                   const size_t count) const noexcept {
+    // always 4 hops (src -> L1Switch -> L2Switch -> L1Switch -> dest)
+    std::fill(hops_counts, hops_counts + count, 4);
 }
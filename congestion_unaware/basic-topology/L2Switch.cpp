@@ -4,6 +4,7 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_unaware/Switch.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace NetworkAnalytical;
@@ -19,11 +20,10 @@ L2Switch::L2Switch(const int npus_count, const Bandwidth bandwidth, const Latenc
     basic_topology_type = TopologyBuildingBlock::L2Switch;
 }
 
-int L2Switch::compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept {
-    assert(0 <= src && src < npus_count);
-    assert(0 <= dest && dest < npus_count);
-    assert(src != dest);
-
-    // for L2Switch, hops_count is always 2 (src -> L2Switch -> dest)
-    return 2;
+void L2Switch::compute_hops_counts(const DeviceId* const srcs,
+                                   const DeviceId* const dests,
+                                   int* const hops_counts,
+                                   const size_t count) const noexcept {
+    // always 2 hops (src -> L2Switch -> dest)
+    std::fill(hops_counts, hops_counts + count, 2);
 }
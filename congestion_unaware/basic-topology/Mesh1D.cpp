@@ -21,11 +21,11 @@ Mesh1D::Mesh1D(const int npus_count, const Bandwidth bandwidth, const Latency la
     basic_topology_type = TopologyBuildingBlock::Mesh1D;
 }
 
-// Mesh 1D default distance is the absolute difference between the source and destination
-int Mesh1D::compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept {
-    assert(0 <= src && src < npus_count);
-    assert(0 <= dest && dest < npus_count);
-    assert(src != dest);
-
-    return abs(dest - src);
-}
\ No newline at end of file
+void Mesh1D::compute_hops_counts(const DeviceId* const srcs,
+                                 const DeviceId* const dests,
+                                 int* const hops_counts,
+                                 const size_t count) const noexcept {
+    for (auto i = size_t(0); i < count; i++) {
+        hops_counts[i] = abs(dests[i] - srcs[i]);
+    }
+}
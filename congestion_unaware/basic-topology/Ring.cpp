@@ -4,6 +4,7 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_unaware/Ring.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace NetworkAnalytical;
@@ -20,30 +21,22 @@ Ring::Ring(const int npus_count, const Bandwidth bandwidth, const Latency latenc
     basic_topology_type = TopologyBuildingBlock::Ring;
 }
 
-int Ring::compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept {
-    assert(0 <= src && src < npus_count);
-    assert(0 <= dest && dest < npus_count);
-    assert(src != dest);
-
-    // for Ring topology
-    // 1. compute clockwise and anti-clockwise distance
-    // 2. if unidirectional, use clockwise one
-    // 3. if bidirectional, use the shorter one
-
-    // compute clockwise distance
-    auto clockwise_distance = (dest - src);
-    if (clockwise_distance < 0) {
-        clockwise_distance += npus_count;
-    }
-
-    // compute anticlockwise distance
-    const auto anticlockwise_distance = npus_count - clockwise_distance;
-
-    // unidirectional: return clockwise distance
+void Ring::compute_hops_counts(const DeviceId* const srcs,
+                               const DeviceId* const dests,
+                               int* const hops_counts,
+                               const size_t count) const noexcept {
+    // same as compute_hops_count, branch-free so that the loops vectorize
     if (!bidirectional) {
-        return clockwise_distance;
+        for (auto i = size_t(0); i < count; i++) {
+            const auto clockwise_distance = dests[i] - srcs[i];
+            hops_counts[i] = clockwise_distance + ((clockwise_distance < 0) ? npus_count : 0);
+        }
+        return;
     }
 
-    // bidirectional: return shorter distance
-    return (clockwise_distance < anticlockwise_distance) ? clockwise_distance : anticlockwise_distance;
+    for (auto i = size_t(0); i < count; i++) {
+        auto clockwise_distance = dests[i] - srcs[i];
+        clockwise_distance += (clockwise_distance < 0) ? npus_count : 0;
+        hops_counts[i] = std::min(clockwise_distance, npus_count - clockwise_distance);
+    }
 }
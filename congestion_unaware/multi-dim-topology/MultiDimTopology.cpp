@@ -4,6 +4,7 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_unaware/MultiDimTopology.h"
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
@@ -42,12 +43,145 @@ EventTime MultiDimTopology::send(const DeviceId src, const DeviceId dest, const
     return comms_delay;
 }
 
+void MultiDimTopology::send_batch(const DeviceId* const srcs,
+                                  const DeviceId* const dests,
+                                  const ChunkSize* const chunk_sizes,
+                                  EventTime* const delays,
+                                  const size_t count) const noexcept {
+    // dimension and local addresses of each chunk of a block
+    auto dims = std::array<int, batch_block_size>();
+    auto local_srcs = std::array<DeviceId, batch_block_size>();
+    auto local_dests = std::array<DeviceId, batch_block_size>();
+
+    // chunks of a block grouped by dimension: chunks of dim are at [offsets[dim], offsets[dim + 1])
+    auto offsets = std::array<size_t, max_dims_count + 1>();
+    auto chunk_indices = std::array<uint32_t, batch_block_size>();
+    auto grouped_srcs = std::array<DeviceId, batch_block_size>();
+    auto grouped_dests = std::array<DeviceId, batch_block_size>();
+    auto grouped_chunk_sizes = std::array<ChunkSize, batch_block_size>();
+    auto grouped_delays = std::array<EventTime, batch_block_size>();
+
+    for (auto start = size_t(0); start < count; start += batch_block_size) {
+        const auto block_count = std::min(batch_block_size, count - start);
+
+        // locate every transfer, counting the chunks per dimension
+        offsets.fill(0);
+        for (auto i = size_t(0); i < block_count; i++) {
+            const auto src = srcs[start + i];
+            const auto dest = dests[start + i];
+            assert(0 <= src && src < npus_count);
+            assert(0 <= dest && dest < npus_count);
+            assert(src != dest);
+
+            // src and dest differ at dim or above iff their quotients by the stride of dim differ:
+            // scanned from the top dimension, which most of the chunks transfer in, lower addresses are never computed
+            auto dim = dims_count - 1;
+            auto src_quotient = stride_divisor_per_dim[dim].divide(static_cast<uint32_t>(src));
+            auto dest_quotient = stride_divisor_per_dim[dim].divide(static_cast<uint32_t>(dest));
+            while (src_quotient == dest_quotient) {
+                dim--;
+                src_quotient = stride_divisor_per_dim[dim].divide(static_cast<uint32_t>(src));
+                dest_quotient = stride_divisor_per_dim[dim].divide(static_cast<uint32_t>(dest));
+            }
+
+            // addresses in the dimension
+            const auto& divisor = divisor_per_dim[dim];
+            dims[i] = dim;
+            local_srcs[i] = static_cast<DeviceId>(src_quotient - divisor.divide(src_quotient) * divisor.get_divisor());
+            local_dests[i] =
+                static_cast<DeviceId>(dest_quotient - divisor.divide(dest_quotient) * divisor.get_divisor());
+            offsets[dim + 1]++;
+        }
+        for (auto dim = 0; dim < dims_count; dim++) {
+            offsets[dim + 1] += offsets[dim];
+        }
+
+        // group the chunks by dimension
+        auto next_positions = offsets;
+        for (auto i = size_t(0); i < block_count; i++) {
+            const auto position = next_positions[dims[i]]++;
+            chunk_indices[position] = static_cast<uint32_t>(i);
+            grouped_srcs[position] = local_srcs[i];
+            grouped_dests[position] = local_dests[i];
+            grouped_chunk_sizes[position] = chunk_sizes[start + i];
+        }
+
+        // send the chunks of each dimension at once
+        for (auto dim = 0; dim < dims_count; dim++) {
+            const auto dim_start = offsets[dim];
+            const auto dim_count = offsets[dim + 1] - dim_start;
+            if (dim_count > 0) {
+                topology_per_dim[dim]->send_batch(grouped_srcs.data() + dim_start, grouped_dests.data() + dim_start,
+                                                  grouped_chunk_sizes.data() + dim_start,
+                                                  grouped_delays.data() + dim_start, dim_count);
+            }
+        }
+
+        // scatter the delays back in the order of the chunks
+        for (auto position = size_t(0); position < block_count; position++) {
+            delays[start + chunk_indices[position]] = grouped_delays[position];
+        }
+    }
+}
+
+EventTime MultiDimTopology::estimate_collective(const CollectiveType type,
+                                                const CollectiveAlgorithm algorithm,
+                                                const ChunkSize size) const noexcept {
+    auto topologies = std::array<const BasicTopology*, max_dims_count>();
+    for (auto dim = 0; dim < dims_count; dim++) {
+        topologies[dim] = topology_per_dim[dim].get();
+    }
+
+    return estimate_hierarchical_collective(topologies.data(), dims_count, type, algorithm, size);
+}
+
+EventTime MultiDimTopology::estimate_hierarchical_collective(const BasicTopology* const* const topology_per_dim,
+                                                             const int dims_count,
+                                                             const CollectiveType type,
+                                                             const CollectiveAlgorithm algorithm,
+                                                             const ChunkSize size) noexcept {
+    assert(size > 0);
+
+    // all-reduce is a reduce-scatter followed by an all-gather, except on trees
+    if (type == CollectiveType::AllReduce && algorithm != CollectiveAlgorithm::Tree) {
+        return estimate_hierarchical_collective(topology_per_dim, dims_count, CollectiveType::ReduceScatter,
+                                                algorithm, size) +
+               estimate_hierarchical_collective(topology_per_dim, dims_count, CollectiveType::AllGather, algorithm,
+                                                size);
+    }
+
+    // only reduce-scatter and all-gather shrink the buffer along the dimensions
+    const auto shrinking = (type == CollectiveType::ReduceScatter || type == CollectiveType::AllGather);
+
+    auto collective_delay = EventTime(0);
+    auto dim_size = size;
+    for (auto dim = 0; dim < dims_count; dim++) {
+        const auto* const topology = topology_per_dim[dim];
+        collective_delay += topology->estimate_collective(type, algorithm, dim_size);
+
+        if (shrinking) {
+            const auto dim_npus_count = static_cast<ChunkSize>(topology->get_npus_count());
+            dim_size = std::max<ChunkSize>((dim_size + dim_npus_count - 1) / dim_npus_count, 1);
+        }
+    }
+
+    return collective_delay;
+}
+
 void MultiDimTopology::append_dimension(std::unique_ptr<BasicTopology> topology) noexcept {
+    // addresses are bounded by max_dims_count
+    if (dims_count >= max_dims_count) {
+        std::cerr << "[Error] (network/analytical/congestion_unaware): " << "at most " << max_dims_count
+                  << " dimensions are supported" << std::endl;
+        std::exit(-1);
+    }
+
     // increment dims_count
     dims_count++;
 
-    // increase npus_count
+    // NPUs of the lower dimensions are the stride of this one, then increase npus_count
     const auto topology_size = topology->get_npus_count();
+    stride_divisor_per_dim.emplace_back(npus_count);
     npus_count *= topology_size;
 
     // append bandwidth
@@ -57,40 +191,29 @@ void MultiDimTopology::append_dimension(std::unique_ptr<BasicTopology> topology)
     // push back topology and npus_count
     topology_per_dim.push_back(std::move(topology));
     npus_count_per_dim.push_back(topology_size);
+    divisor_per_dim.emplace_back(topology_size);
 }
 
 MultiDimTopology::MultiDimAddress MultiDimTopology::translate_address(const DeviceId npu_id) const noexcept {
+    assert(0 <= npu_id && npu_id < npus_count);
+
     // If units-count if [2, 8, 4], and the given id is 47, then the id should be
-    // 47 // 16 = 2, leftover = 47 % 16 = 15
-    // 15 // 2 = 7, leftover = 15 % 2 = 1
-    // 1 // 1 = 1, leftover = 0
+    // 47 % 2 = 1, quotient = 47 // 2 = 23
+    // 23 % 8 = 7, quotient = 23 // 8 = 2
+    // 2 % 4 = 2
     // therefore the address is [1, 7, 2]
 
-    // create empty address
     auto multi_dim_address = MultiDimAddress();
-    for (auto i = 0; i < dims_count; i++) {
-        multi_dim_address.push_back(-1);
-    }
-
-    auto leftover = npu_id;
-    auto denominator = npus_count;
+    auto quotient = static_cast<uint32_t>(npu_id);
 
-    for (auto dim = dims_count - 1; dim >= 0; dim--) {
-        // change denominator
-        denominator /= npus_count_per_dim[dim];
-
-        // get and update address
-        const auto quotient = leftover / denominator;
-        leftover %= denominator;
-
-        // update address
-        multi_dim_address[dim] = quotient;
-    }
+    for (auto dim = 0; dim < dims_count; dim++) {
+        // divide without the hardware division, and get the remainder out of the quotient
+        const auto& divisor = divisor_per_dim[dim];
+        const auto next_quotient = divisor.divide(quotient);
+        multi_dim_address[dim] = static_cast<DeviceId>(quotient - next_quotient * divisor.get_divisor());
+        quotient = next_quotient;
 
-    // check address translation
-    for (auto i = 0; i < dims_count; i++) {
-        assert(0 <= multi_dim_address[i]);
-        assert(multi_dim_address[i] < npus_count_per_dim[i]);
+        assert(0 <= multi_dim_address[dim] && multi_dim_address[dim] < npus_count_per_dim[dim]);
     }
 
     // return retrieved address
@@ -0,0 +1,43 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_unaware/StaticMultiDimTopology.h"
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+
+namespace {
+
+/**
+ * Construct the first alternative of StaticTopology, from the given one,
+ * whose building blocks match a NetworkParser.
+ *
+ * @tparam Index index of the alternative to try first
+ * @param network_parser NetworkParser to parse the network input file
+ * @param topologies_per_dim building block per each dimension
+ * @return the constructed topology, std::nullopt if no alternative matches
+ */
+template <size_t Index>
+std::optional<StaticTopology> construct_alternative(const NetworkParser& network_parser,
+                                                    const std::vector<TopologyBuildingBlock>& topologies_per_dim) noexcept {
+    if constexpr (Index == std::variant_size_v<StaticTopology>) {
+        return std::nullopt;
+    } else {
+        using Alternative = std::variant_alternative_t<Index, StaticTopology>;
+        if (!Alternative::has_building_blocks(topologies_per_dim)) {
+            return construct_alternative<Index + 1>(network_parser, topologies_per_dim);
+        }
+
+        return StaticTopology(std::in_place_index<Index>, network_parser.get_npus_counts_per_dim(),
+                              network_parser.get_bandwidths_per_dim(), network_parser.get_latencies_per_dim());
+    }
+}
+
+}  // namespace
+
+std::optional<StaticTopology> NetworkAnalyticalCongestionUnaware::construct_static_topology(
+    const NetworkParser& network_parser) noexcept {
+    return construct_alternative<0>(network_parser, network_parser.get_topologies_per_dim());
+}
@@ -17,7 +17,8 @@ using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
 
 std::shared_ptr<Topology> NetworkAnalyticalCongestionUnaware::construct_topology(
-    const NetworkParser& network_parser) noexcept {
+    const NetworkParser& network_parser,
+    const bool link_delay_tables) noexcept {
     // get network_parser info
     const auto dims_count = network_parser.get_dims_count();
     const auto topologies_per_dim = network_parser.get_topologies_per_dim();
@@ -33,25 +34,38 @@ std::shared_ptr<Topology> NetworkAnalyticalCongestionUnaware::construct_topology
         const auto bandwidth = bandwidths_per_dim[0];
         const auto latency = latencies_per_dim[0];
 
-        // create and return basic topology
+        // create basic topology
+        std::shared_ptr<BasicTopology> basic_topology;
         switch (topology_type) {
         case TopologyBuildingBlock::Ring:
-            return std::make_shared<Ring>(npus_count, bandwidth, latency);
+            basic_topology = std::make_shared<Ring>(npus_count, bandwidth, latency);
+            break;
         case TopologyBuildingBlock::Switch:
-            return std::make_shared<Switch>(npus_count, bandwidth, latency);
+            basic_topology = std::make_shared<Switch>(npus_count, bandwidth, latency);
+            break;
         case TopologyBuildingBlock::L2Switch:
-            return std::make_shared<L2Switch>(npus_count, bandwidth, latency);
+            basic_topology = std::make_shared<L2Switch>(npus_count, bandwidth, latency);
+            break;
         case TopologyBuildingBlock::L1Switch:
-            return std::make_shared<L1Switch>(npus_count, bandwidth, latency);
+            basic_topology = std::make_shared<L1Switch>(npus_count, bandwidth, latency);
+            break;
         case TopologyBuildingBlock::FullyConnected:
-            return std::make_shared<FullyConnected>(npus_count, bandwidth, latency);
+            basic_topology = std::make_shared<FullyConnected>(npus_count, bandwidth, latency);
+            break;
         case TopologyBuildingBlock::Mesh1D:
-            return std::make_shared<Mesh1D>(npus_count, bandwidth, latency);
+            basic_topology = std::make_shared<Mesh1D>(npus_count, bandwidth, latency);
+            break;
         default:
             // shouldn't reach here
             std::cerr << "[Error] (network/analytical/congestion_unaware)" << "Not supported topology" << std::endl;
             std::exit(-1);
         }
+
+        // tabulate link delays if requested, then return basic topology
+        if (link_delay_tables) {
+            basic_topology->build_link_delay_table();
+        }
+        return basic_topology;
     }
 
     // otherwise, create multi-dim basic-topology
@@ -93,6 +107,11 @@ std::shared_ptr<Topology> NetworkAnalyticalCongestionUnaware::construct_topology
             std::exit(-1);
         }
 
+        // tabulate link delays if requested
+        if (link_delay_tables) {
+            dim_topology->build_link_delay_table();
+        }
+
         // append network dimension
         multi_dim_topology->append_dimension(std::move(dim_topology));
     }
@@ -11,6 +11,16 @@ using namespace NetworkAnalyticalCongestionUnaware;
 
 Topology::Topology() noexcept : npus_count(-1), dims_count(-1) {}
 
+void Topology::send_batch(const DeviceId* const srcs,
+                          const DeviceId* const dests,
+                          const ChunkSize* const chunk_sizes,
+                          EventTime* const delays,
+                          const size_t count) const noexcept {
+    for (auto i = size_t(0); i < count; i++) {
+        delays[i] = send(srcs[i], dests[i], chunk_sizes[i]);
+    }
+}
+
 int Topology::get_npus_count() const noexcept {
     assert(npus_count > 0);
 
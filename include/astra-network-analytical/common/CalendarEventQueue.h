@@ -0,0 +1,114 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventList.h"
+#include "common/EventQueueBackend.h"
+#include "common/MemoryPool.h"
+#include "common/Type.h"
+#include <cstddef>
+#include <list>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * CalendarEventQueue implements the calendar queue (R. Brown, 1988).
+ *
+ * Event times are hashed into a circular array of buckets ("days"),
+ * each covering bucket_width ns, and each bucket keeps its EventLists sorted.
+ * The number of buckets follows the number of pending EventLists
+ * and the bucket width is re-estimated from the event time distribution on resize,
+ * so that both scheduling and popping take O(1) amortized time.
+ */
+class CalendarEventQueue final : public EventQueueBackend {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param memory_pool pool to allocate EventLists from
+     */
+    explicit CalendarEventQueue(MemoryPool* memory_pool) noexcept;
+
+    /**
+     * Implementation of empty function in EventQueueBackend.
+     */
+    [[nodiscard]] bool empty() const noexcept override;
+
+    /**
+     * Implementation of schedule_event function in EventQueueBackend.
+     */
+    void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept override;
+
+    /**
+     * Implementation of pop_front function in EventQueueBackend.
+     */
+    [[nodiscard]] EventList pop_front() noexcept override;
+
+  private:
+    /// bucket of EventLists, sorted by event time
+    using Bucket = std::list<EventList, PoolAllocator<EventList>>;
+
+    /// minimum number of buckets
+    static constexpr size_t min_buckets_count = 2;
+
+    /// number of samples used to estimate the bucket width
+    static constexpr size_t width_samples_count = 25;
+
+    /// pool to allocate EventLists from
+    MemoryPool* memory_pool;
+
+    /// buckets of EventLists
+    std::vector<Bucket> buckets;
+
+    /// time span covered by a single bucket
+    EventTime bucket_width;
+
+    /// number of scheduled EventLists
+    size_t event_lists_count;
+
+    /// bucket of the last popped EventList
+    size_t last_bucket;
+
+    /// upper bound (exclusive) of the event time served by last_bucket in the current year
+    EventTime bucket_top;
+
+    /// event time of the last popped EventList
+    EventTime last_event_time;
+
+    /**
+     * Get the bucket index a given event time is hashed to.
+     *
+     * @param event_time event time
+     * @return bucket index
+     */
+    [[nodiscard]] size_t bucket_index(EventTime event_time) const noexcept;
+
+    /**
+     * Find the bucket holding the earliest EventList
+     * and move last_bucket and bucket_top to it.
+     */
+    void locate_front() noexcept;
+
+    /**
+     * Rebuild the calendar with a new number of buckets,
+     * re-estimating the bucket width.
+     *
+     * @param new_buckets_count number of buckets after resizing
+     */
+    void resize(size_t new_buckets_count) noexcept;
+
+    /**
+     * Estimate the bucket width from the given event times,
+     * i.e., three times the average gap between the earliest event times.
+     *
+     * @param event_times event times of the scheduled EventLists
+     * @return estimated bucket width
+     */
+    [[nodiscard]] static EventTime estimate_bucket_width(std::vector<EventTime> event_times) noexcept;
+};
+
+}  // namespace NetworkAnalytical
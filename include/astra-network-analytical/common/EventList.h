@@ -6,6 +6,7 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Event.h"
+#include "common/MemoryPool.h"
 #include "common/Type.h"
 #include <list>
 
@@ -20,8 +21,9 @@ class EventList {
      * Constructor.
      *
      * @param event_time event time of the event list
+     * @param memory_pool pool to allocate events from, nullptr to use the heap
      */
-    explicit EventList(EventTime event_time) noexcept;
+    explicit EventList(EventTime event_time, MemoryPool* memory_pool = nullptr) noexcept;
 
     /**
      * Get the registered event time.
@@ -48,7 +50,7 @@ class EventList {
     EventTime event_time;
 
     /// list of registered events
-    std::list<Event> events;
+    std::list<Event, PoolAllocator<Event>> events;
 };
 
 }  // namespace NetworkAnalytical
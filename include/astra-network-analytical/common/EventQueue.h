@@ -6,7 +6,11 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/EventList.h"
+#include "common/EventQueueBackend.h"
+#include "common/MemoryPool.h"
 #include "common/Type.h"
+#include <cstdint>
+#include <memory>
 
 namespace NetworkAnalytical {
 
@@ -17,8 +21,10 @@ class EventQueue {
   public:
     /**
      * Constructor.
+     *
+     * @param event_queue_type data structure to keep the scheduled EventLists
      */
-    EventQueue() noexcept;
+    explicit EventQueue(EventQueueType event_queue_type = EventQueueType::List) noexcept;
 
     /**
      * Get current event time of the event queue.
@@ -52,12 +58,38 @@ class EventQueue {
      */
     void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept;
 
+    /**
+     * Get the number of events scheduled so far.
+     *
+     * @return number of scheduled events
+     */
+    [[nodiscard]] uint64_t get_scheduled_events_count() const noexcept;
+
+    /**
+     * Get the memory pool backing the scheduled events,
+     * e.g., to check its allocation statistics.
+     *
+     * @return memory pool of the event queue
+     */
+    [[nodiscard]] const MemoryPool& get_memory_pool() const noexcept;
+
   private:
     /// current time of the event queue
     EventTime current_time;
 
-    /// list of EventLists
-    std::list<EventList> event_queue;
+    /// number of events scheduled so far
+    uint64_t scheduled_events_count;
+
+    /// memory pool recycling EventLists and Events
+    /// declared before event_queue, so that it outlives the scheduled events
+    MemoryPool memory_pool;
+
+    /// scheduled EventLists
+    std::unique_ptr<EventQueueBackend> event_queue;
+
+    /// EventList being invoked by proceed(), nullptr otherwise
+    /// events scheduled at the current time during proceed() are appended to it
+    EventList* current_event_list;
 };
 
 }  // namespace NetworkAnalytical
@@ -0,0 +1,52 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventList.h"
+#include "common/Type.h"
+
+namespace NetworkAnalytical {
+
+/**
+ * EventQueueBackend abstracts the data structure
+ * that keeps the scheduled EventLists sorted by their event time.
+ *
+ * Backends allocate EventLists (and their Events) from the MemoryPool of the EventQueue,
+ * so that the storage of invoked events is recycled for newly scheduled ones.
+ */
+class EventQueueBackend {
+  public:
+    /**
+     * Destructor.
+     */
+    virtual ~EventQueueBackend() noexcept = default;
+
+    /**
+     * Check if no EventList is scheduled.
+     *
+     * @return true if the backend is empty, false otherwise
+     */
+    [[nodiscard]] virtual bool empty() const noexcept = 0;
+
+    /**
+     * Register an event into the EventList matching with the event time.
+     * A new EventList is created if there's no matching one.
+     *
+     * @param event_time time of event
+     * @param callback callback function pointer
+     * @param callback_arg argument of the callback function
+     */
+    virtual void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept = 0;
+
+    /**
+     * Remove the EventList with the smallest event time.
+     *
+     * @return removed EventList
+     */
+    [[nodiscard]] virtual EventList pop_front() noexcept = 0;
+};
+
+}  // namespace NetworkAnalytical
@@ -0,0 +1,69 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace NetworkAnalytical {
+
+/**
+ * FastDivisor divides 32-bit unsigned integers by a divisor fixed at construction,
+ * replacing the hardware division by a multiplication and a shift
+ * (Lemire et al., "Faster Remainder by Direct Computation", 2019).
+ *
+ * The multiplier is ceil(2^64 / divisor), exact for every 32-bit dividend and divisor.
+ * Falls back to the hardware division where 128-bit integers are not available.
+ */
+class FastDivisor {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param divisor divisor, should be positive
+     */
+    explicit FastDivisor(const uint32_t divisor = 1) noexcept
+        : divisor(divisor),
+          multiplier(UINT64_MAX / divisor + 1) {
+        assert(divisor > 0);
+    }
+
+    /**
+     * Divide a dividend by the divisor.
+     *
+     * @param dividend dividend
+     * @return quotient, rounded down
+     */
+    [[nodiscard]] uint32_t divide(const uint32_t dividend) const noexcept {
+#if defined(__SIZEOF_INT128__)
+        // the multiplier of divisor 1 wraps around to 0
+        if (multiplier == 0) {
+            return dividend;
+        }
+        return static_cast<uint32_t>((static_cast<__uint128_t>(multiplier) * dividend) >> 64);
+#else
+        return dividend / divisor;
+#endif
+    }
+
+    /**
+     * Get the divisor.
+     *
+     * @return divisor
+     */
+    [[nodiscard]] uint32_t get_divisor() const noexcept {
+        return divisor;
+    }
+
+  private:
+    /// divisor
+    uint32_t divisor;
+
+    /// ceil(2^64 / divisor), 0 for divisor 1
+    uint64_t multiplier;
+};
+
+}  // namespace NetworkAnalytical
@@ -0,0 +1,85 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventList.h"
+#include "common/EventQueueBackend.h"
+#include "common/MemoryPool.h"
+#include "common/Type.h"
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * HeapEventQueue keeps pending event times in a 4-ary min-heap,
+ * with a hash table merging the events sharing a timestamp into one EventList.
+ *
+ * Unlike CalendarEventQueue, its O(log n) scheduling cost
+ * doesn't depend on the distribution of event times.
+ */
+class HeapEventQueue final : public EventQueueBackend {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param memory_pool pool to allocate EventLists from
+     */
+    explicit HeapEventQueue(MemoryPool* memory_pool) noexcept;
+
+    /**
+     * Implementation of empty function in EventQueueBackend.
+     */
+    [[nodiscard]] bool empty() const noexcept override;
+
+    /**
+     * Implementation of schedule_event function in EventQueueBackend.
+     */
+    void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept override;
+
+    /**
+     * Implementation of pop_front function in EventQueueBackend.
+     */
+    [[nodiscard]] EventList pop_front() noexcept override;
+
+  private:
+    /// hash table of EventLists, indexed by event time
+    using EventListMap = std::unordered_map<EventTime,
+                                            EventList,
+                                            std::hash<EventTime>,
+                                            std::equal_to<EventTime>,
+                                            PoolAllocator<std::pair<const EventTime, EventList>>>;
+
+    /// number of children per heap node
+    static constexpr size_t arity = 4;
+
+    /// min-heap of distinct pending event times
+    std::vector<EventTime> event_times;
+
+    /// pool to allocate EventLists from
+    MemoryPool* memory_pool;
+
+    /// map[event time] -> EventList
+    EventListMap event_lists;
+
+    /**
+     * Move the heap entry at the given index up to its position.
+     *
+     * @param index index of the heap entry
+     */
+    void sift_up(size_t index) noexcept;
+
+    /**
+     * Move the heap entry at the given index down to its position.
+     *
+     * @param index index of the heap entry
+     */
+    void sift_down(size_t index) noexcept;
+};
+
+}  // namespace NetworkAnalytical
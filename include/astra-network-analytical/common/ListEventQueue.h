@@ -0,0 +1,52 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventList.h"
+#include "common/EventQueueBackend.h"
+#include "common/MemoryPool.h"
+#include "common/Type.h"
+#include <list>
+
+namespace NetworkAnalytical {
+
+/**
+ * ListEventQueue keeps EventLists in a sorted linked list.
+ * Scheduling an event is O(n) in the number of pending event times.
+ */
+class ListEventQueue final : public EventQueueBackend {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param memory_pool pool to allocate EventLists from
+     */
+    explicit ListEventQueue(MemoryPool* memory_pool) noexcept;
+
+    /**
+     * Implementation of empty function in EventQueueBackend.
+     */
+    [[nodiscard]] bool empty() const noexcept override;
+
+    /**
+     * Implementation of schedule_event function in EventQueueBackend.
+     */
+    void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept override;
+
+    /**
+     * Implementation of pop_front function in EventQueueBackend.
+     */
+    [[nodiscard]] EventList pop_front() noexcept override;
+
+  private:
+    /// pool to allocate EventLists from
+    MemoryPool* memory_pool;
+
+    /// list of EventLists, sorted by event time
+    std::list<EventList, PoolAllocator<EventList>> event_queue;
+};
+
+}  // namespace NetworkAnalytical
@@ -0,0 +1,216 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * MemoryPool is a slab allocator for small, frequently recycled objects.
+ *
+ * Requests are rounded up to a size class, and each size class keeps a free list of blocks
+ * carved out of large slabs. Freed blocks are recycled by later requests,
+ * so once the pool has grown to the peak working set, allocations don't reach the heap anymore.
+ * Requests larger than the biggest size class fall back to operator new.
+ */
+class MemoryPool {
+  public:
+    /// largest block size served from slabs, larger requests fall back to operator new
+    static constexpr size_t max_block_size = 256;
+
+    /**
+     * Constructor.
+     */
+    MemoryPool() noexcept;
+
+    /**
+     * Destructor.
+     * Releases every slab, so all blocks should have been returned already.
+     */
+    ~MemoryPool() noexcept;
+
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    /**
+     * Allocate a block.
+     *
+     * @param size size of the block in bytes
+     * @return pointer to the allocated block
+     */
+    [[nodiscard]] void* allocate(size_t size) noexcept;
+
+    /**
+     * Return a block to the pool.
+     *
+     * @param ptr pointer to the block
+     * @param size size of the block in bytes, same as the one requested to allocate()
+     */
+    void deallocate(void* ptr, size_t size) noexcept;
+
+    /**
+     * Get the number of heap allocations made by the pool,
+     * i.e., slabs and blocks too large for the size classes.
+     *
+     * @return number of heap allocations
+     */
+    [[nodiscard]] uint64_t get_heap_allocations_count() const noexcept;
+
+    /**
+     * Get the number of blocks handed out so far.
+     *
+     * @return number of allocated blocks
+     */
+    [[nodiscard]] uint64_t get_allocations_count() const noexcept;
+
+    /**
+     * Get the number of blocks currently in use.
+     *
+     * @return number of live blocks
+     */
+    [[nodiscard]] uint64_t get_live_blocks_count() const noexcept;
+
+    /**
+     * Get the largest number of blocks that were in use at once.
+     *
+     * @return peak number of live blocks
+     */
+    [[nodiscard]] uint64_t get_peak_live_blocks_count() const noexcept;
+
+  private:
+    /// blocks are aligned to (and sized in multiples of) this value
+    static constexpr size_t block_alignment = alignof(std::max_align_t);
+
+    /// size of a single slab
+    static constexpr size_t slab_size = 64 * 1024;
+
+    /// number of size classes
+    static constexpr size_t size_classes_count = max_block_size / block_alignment;
+
+    /// free block, linked into the free list of its size class
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    /// free list per each size class
+    std::array<FreeBlock*, size_classes_count> free_lists;
+
+    /// slabs allocated from the heap
+    std::vector<void*> slabs;
+
+    /// number of heap allocations
+    uint64_t heap_allocations_count;
+
+    /// number of allocated blocks
+    uint64_t allocations_count;
+
+    /// number of live blocks
+    uint64_t live_blocks_count;
+
+    /// peak number of live blocks
+    uint64_t peak_live_blocks_count;
+
+    /**
+     * Get the size class of a given block size.
+     *
+     * @param size block size in bytes
+     * @return size class index
+     */
+    [[nodiscard]] static size_t size_class(size_t size) noexcept;
+
+    /**
+     * Allocate a new slab and carve it into free blocks of the given size class.
+     *
+     * @param size_class_index size class to refill
+     */
+    void refill(size_t size_class_index) noexcept;
+};
+
+/**
+ * PoolAllocator is an STL-compatible allocator drawing memory from a MemoryPool.
+ * A default-constructed PoolAllocator falls back to operator new.
+ *
+ * @tparam T type of the allocated objects
+ */
+template <typename T> class PoolAllocator {
+  public:
+    using value_type = T;
+
+    /**
+     * Constructor, allocating from the heap.
+     */
+    PoolAllocator() noexcept : memory_pool(nullptr) {}
+
+    /**
+     * Constructor.
+     *
+     * @param memory_pool pool to allocate from
+     */
+    explicit PoolAllocator(MemoryPool* const memory_pool) noexcept : memory_pool(memory_pool) {}
+
+    /**
+     * Rebinding constructor.
+     *
+     * @param other allocator of another type sharing the same pool
+     */
+    template <typename U> PoolAllocator(const PoolAllocator<U>& other) noexcept : memory_pool(other.get_memory_pool()) {}
+
+    /**
+     * Allocate memory for n objects.
+     *
+     * @param n number of objects
+     * @return pointer to the allocated memory
+     */
+    [[nodiscard]] T* allocate(const size_t n) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+
+        if (memory_pool == nullptr) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(memory_pool->allocate(n * sizeof(T)));
+    }
+
+    /**
+     * Deallocate memory for n objects.
+     *
+     * @param ptr pointer to the memory
+     * @param n number of objects
+     */
+    void deallocate(T* const ptr, const size_t n) noexcept {
+        if (memory_pool == nullptr) {
+            ::operator delete(ptr);
+            return;
+        }
+        memory_pool->deallocate(ptr, n * sizeof(T));
+    }
+
+    /**
+     * Get the pool the allocator draws memory from.
+     *
+     * @return memory pool, nullptr if allocating from the heap
+     */
+    [[nodiscard]] MemoryPool* get_memory_pool() const noexcept {
+        return memory_pool;
+    }
+
+  private:
+    /// pool to allocate from
+    MemoryPool* memory_pool;
+};
+
+template <typename T, typename U> bool operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) noexcept {
+    return lhs.get_memory_pool() == rhs.get_memory_pool();
+}
+
+template <typename T, typename U> bool operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+}  // namespace NetworkAnalytical
@@ -60,6 +60,13 @@ class NetworkParser {
      */
     [[nodiscard]] std::vector<TopologyBuildingBlock> get_topologies_per_dim() const noexcept;
 
+    /**
+     * Read the optional "packet_size" value.
+     *
+     * @return size of a packet in bytes, 0 if messages aren't split into packets
+     */
+    [[nodiscard]] ChunkSize get_packet_size() const noexcept;
+
   private:
     /// number of network dimensions
     int dims_count;
@@ -76,6 +83,9 @@ class NetworkParser {
     /// topology building block per each dimension
     std::vector<TopologyBuildingBlock> topology_per_dim;
 
+    /// size of a packet, 0 if messages aren't split into packets
+    ChunkSize packet_size;
+
     /**
      * Parse topology name (in string) into TopologyBuildingBlock enum
      *
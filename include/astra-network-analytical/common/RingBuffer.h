@@ -0,0 +1,132 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace NetworkAnalytical {
+
+/**
+ * RingBuffer is a FIFO queue stored in a contiguous circular array.
+ *
+ * The capacity is a power of two, doubled whenever the buffer is full,
+ * so once the buffer has grown to its peak occupancy, pushing and popping never allocate.
+ *
+ * @tparam T type of the elements, default-constructible and movable
+ */
+template <typename T> class RingBuffer {
+  public:
+    /// capacity of a buffer upon its first push
+    static constexpr size_t initial_capacity = 8;
+
+    /**
+     * Constructor.
+     * No memory is allocated until the first push.
+     */
+    RingBuffer() noexcept : elements(nullptr), capacity(0), head(0), elements_count(0) {}
+
+    RingBuffer(RingBuffer&& ring_buffer) noexcept = default;
+    RingBuffer& operator=(RingBuffer&& ring_buffer) noexcept = default;
+
+    /**
+     * Append an element at the back.
+     *
+     * @param element element to append
+     */
+    void push_back(T element) noexcept {
+        if (elements_count == capacity) {
+            grow();
+        }
+
+        elements[(head + elements_count) & (capacity - 1)] = std::move(element);
+        elements_count++;
+    }
+
+    /**
+     * Remove the front element.
+     *
+     * @return removed element
+     */
+    [[nodiscard]] T pop_front() noexcept {
+        assert(!empty());
+
+        auto element = std::move(elements[head]);
+        head = (head + 1) & (capacity - 1);
+        elements_count--;
+        return element;
+    }
+
+    /**
+     * Get the front element.
+     *
+     * @return front element
+     */
+    [[nodiscard]] T& front() const noexcept {
+        assert(!empty());
+
+        return elements[head];
+    }
+
+    /**
+     * Get the number of elements.
+     *
+     * @return number of elements
+     */
+    [[nodiscard]] size_t size() const noexcept {
+        return elements_count;
+    }
+
+    /**
+     * Check if the buffer is empty.
+     *
+     * @return true if empty, false otherwise
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return elements_count == 0;
+    }
+
+    /**
+     * Get the number of elements the buffer can hold without growing.
+     *
+     * @return capacity
+     */
+    [[nodiscard]] size_t get_capacity() const noexcept {
+        return capacity;
+    }
+
+  private:
+    /// circular array of elements
+    std::unique_ptr<T[]> elements;
+
+    /// size of the array, zero or a power of two
+    size_t capacity;
+
+    /// index of the front element
+    size_t head;
+
+    /// number of elements
+    size_t elements_count;
+
+    /**
+     * Double the capacity, moving the elements to the front of the new array.
+     */
+    void grow() noexcept {
+        const auto new_capacity = (capacity == 0) ? initial_capacity : capacity * 2;
+        auto new_elements = std::make_unique<T[]>(new_capacity);
+        for (size_t i = 0; i < elements_count; i++) {
+            new_elements[i] = std::move(elements[(head + i) & (capacity - 1)]);
+        }
+
+        elements = std::move(new_elements);
+        capacity = new_capacity;
+        head = 0;
+    }
+};
+
+}  // namespace NetworkAnalytical
@@ -30,7 +30,45 @@ using Latency = double;
 /// Event time in ns
 using EventTime = uint64_t;
 
+/// Data structures backing the EventQueue
+enum class EventQueueType { List, Calendar, Heap };
+
 /// Basic multi-dimensional topology building blocks
 enum class TopologyBuildingBlock { Undefined, Ring, FullyConnected, Switch, L2Switch, L1Switch, Mesh2D, Mesh1D, Tree, CloudMatrix384, SpinalSwitch, VirtualSwitch };
 
+/**
+ * Collective communication patterns,
+ * shared by the collective schedules (congestion_aware) and cost models (congestion_unaware).
+ */
+enum class CollectiveType {
+    /// every NPU ends up with the reduction of every buffer
+    AllReduce,
+
+    /// every NPU ends up with the concatenation of every piece
+    AllGather,
+
+    /// every NPU ends up with the reduction of its own piece of every buffer
+    ReduceScatter,
+
+    /// every NPU sends a distinct piece to every other NPU
+    AllToAll,
+};
+
+/**
+ * Algorithms implementing the collectives.
+ */
+enum class CollectiveAlgorithm {
+    /// pieces travel along the ring 0 -> 1 -> ... -> n-1 -> 0, a step at a time
+    Ring,
+
+    /// binary tree rooted at NPU 0: reduce (or gather) up the tree, then broadcast (or scatter) down
+    Tree,
+
+    /// recursive halving for reductions and recursive doubling for gathers (NPUs count should be a power of 2)
+    HalvingDoubling,
+
+    /// every NPU sends to every other NPU at once
+    Direct,
+};
+
 }  // namespace NetworkAnalytical
@@ -27,8 +27,14 @@ class BasicTopology : public Topology {
      * @param bandwidth bandwidth of each link
      * @param latency latency of each link
      * @param base_id base id of the topology
+     * @param context simulation the topology belongs to
      */
-    BasicTopology(int npus_count, int devices_count, Bandwidth bandwidth, Latency latency, int base_id) noexcept;
+    BasicTopology(int npus_count,
+                  int devices_count,
+                  Bandwidth bandwidth,
+                  Latency latency,
+                  int base_id,
+                  std::shared_ptr<SimulationContext> context) noexcept;
 
     /**
      * Destructor.
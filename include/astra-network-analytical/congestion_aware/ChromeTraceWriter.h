@@ -0,0 +1,116 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Type.h"
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+class Topology;
+
+/**
+ * ChromeTraceWriter exports the activity of a simulation in the Chrome Trace Event JSON format,
+ * to be viewed by Perfetto (ui.perfetto.dev) or chrome://tracing.
+ *
+ *   - Each link becomes a track of the "Links" process, named "src -> dest",
+ *     with a span per each chunk transmission.
+ *   - Each chunk becomes an async span of the "Chunks" process, from its sent time to its arrival,
+ *     with a nested span per each interval it waited for a busy link.
+ *
+ * Events are streamed into the file as they happen, so memory doesn't grow with the simulation length.
+ * Set it to the simulation context of the topology (see SimulationContext::set_chrome_trace_writer)
+ * before sending chunks. Records should be written by a single thread at a time.
+ */
+class ChromeTraceWriter {
+  public:
+    /**
+     * Constructor.
+     * Names the track of every link of the topology.
+     * Exits if the file can't be opened.
+     *
+     * @param path path of the JSON file
+     * @param topology topology whose links are traced
+     */
+    ChromeTraceWriter(const std::string& path, Topology& topology) noexcept;
+
+    /**
+     * Destructor.
+     * Closes the JSON document.
+     */
+    ~ChromeTraceWriter() noexcept;
+
+    ChromeTraceWriter(const ChromeTraceWriter&) = delete;
+    ChromeTraceWriter& operator=(const ChromeTraceWriter&) = delete;
+
+    /**
+     * Write the transmission of a chunk through a link.
+     *
+     * @param link link transmitting the chunk
+     * @param chunk transmitted chunk
+     * @param begin_time time the transmission starts
+     * @param end_time time the link becomes free
+     */
+    void write_transmission(const Link* link, const Chunk& chunk, EventTime begin_time, EventTime end_time) noexcept;
+
+    /**
+     * Write an interval a chunk waited for a busy link.
+     *
+     * @param chunk stalled chunk
+     * @param begin_time time the chunk started waiting
+     * @param end_time time the chunk is served
+     */
+    void write_stall(const Chunk& chunk, EventTime begin_time, EventTime end_time) noexcept;
+
+    /**
+     * Write the lifetime of a chunk arrived at its dest.
+     *
+     * @param chunk arrived chunk
+     * @param sent_time time the chunk is sent
+     * @param arrival_time time the chunk arrives at its dest
+     */
+    void write_chunk(const Chunk& chunk, EventTime sent_time, EventTime arrival_time) noexcept;
+
+    /**
+     * Write the events streamed so far into the file.
+     */
+    void flush() noexcept;
+
+  private:
+    /// id of the "Links" process
+    static constexpr int links_pid = 1;
+
+    /// id of the "Chunks" process
+    static constexpr int chunks_pid = 2;
+
+    /// JSON file
+    std::ofstream file;
+
+    /// track id of each link
+    std::unordered_map<const Link*, int> link_tracks;
+
+    /// flag to indicate if no event is written yet
+    bool first_event;
+
+    /**
+     * Start a new event, separating it from the previous one.
+     */
+    void begin_event() noexcept;
+
+    /**
+     * Write an event time, converted from ns to the us of the trace format.
+     *
+     * @param time event time in ns
+     */
+    void write_time(EventTime time) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
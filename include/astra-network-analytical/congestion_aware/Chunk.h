@@ -6,9 +6,10 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Type.h"
+#include "congestion_aware/Route.h"
+#include "congestion_aware/SimulationContext.h"
 #include "congestion_aware/Type.h"
 #include <memory>
-#include <fstream>
 
 using namespace NetworkAnalytical;
 
@@ -40,26 +41,66 @@ class Chunk {
      */
     Chunk(ChunkSize chunk_size, int chunk_id, Route route, Callback callback, CallbackArg callback_arg) noexcept;
 
+    /**
+     * Allocate a chunk outside of any ChunkPool (e.g., std::make_unique<Chunk>).
+     *
+     * @param size size of the chunk
+     * @return memory of the chunk
+     */
+    static void* operator new(size_t size);
+
+    /**
+     * Release a chunk, recycling it into its ChunkPool if created by one.
+     *
+     * @param chunk_ptr memory of the chunk
+     */
+    static void operator delete(void* chunk_ptr) noexcept;
+
+    /**
+     * Bind the chunk to the simulation it is sent in,
+     * i.e., this method should be called when the chunk is injected into the topology.
+     * The sent time of the chunk is recorded at this moment.
+     *
+     * @param context simulation the chunk is sent in
+     */
+    void set_simulation_context(SimulationContext* context) noexcept;
+
     /**
      * Get the current sitting device of the chunk
      *
      * @return current device of the chunk
      */
-    [[nodiscard]] std::shared_ptr<Device> current_device() const noexcept;
+    [[nodiscard]] Device* current_device() const noexcept;
 
     /**
      * Get the next destined device of the chunk
      *
      * @return next device of the chunk
      */
-    [[nodiscard]] std::shared_ptr<Device> next_device() const noexcept;
+    [[nodiscard]] Device* next_device() const noexcept;
+
+    /**
+     * Get the port of the current device the chunk leaves through, towards its next device.
+     * Ports of the route are resolved upon the first call, if not resolved yet (e.g., by a RouteCache).
+     *
+     * @return port index of the current device
+     */
+    [[nodiscard]] int next_port() noexcept;
 
     /**
      * Mark the chunk arrived at its next device
-     * i.e., drop the current device from the route
+     * i.e., advance the route to the next device
      */
     void mark_arrived_next_device() noexcept;
 
+    /**
+     * Check if the next device of the chunk is its destination
+     * i.e., if the route length is 2
+     *
+     * @return true if the chunk is at the last hop, false otherwise
+     */
+    [[nodiscard]] bool next_device_is_dest() const noexcept;
+
     /**
      * Check if the chunk arrived at its destination
      * i.e., if the route length is 1 (only destination device left)
@@ -82,12 +123,47 @@ class Chunk {
      */
     [[nodiscard]] ChunkSize get_size() const noexcept;
 
+    /**
+     * Split the chunk into packets of the given size.
+     * Packets pipeline through the hops of the route (virtual cut-through):
+     * each hop forwards the head packet as soon as it arrives,
+     * while the chunk still occupies each link for its entire serialization time.
+     *
+     * @param packet_size size of a packet, 0 to send the chunk whole
+     */
+    void set_packet_size(ChunkSize packet_size) noexcept;
+
+    /**
+     * Get the size of the packets the chunk is split into
+     *
+     * @return size of a packet, 0 if the chunk is sent whole
+     */
+    [[nodiscard]] ChunkSize get_packet_size() const noexcept;
+
+    /**
+     * Set the virtual channel the chunk waits in, when a link is busy.
+     *
+     * @param virtual_channel index of the virtual channel
+     */
+    void set_virtual_channel(int virtual_channel) noexcept;
+
+    /**
+     * Get the virtual channel the chunk waits in.
+     *
+     * @return index of the virtual channel
+     */
+    [[nodiscard]] int get_virtual_channel() const noexcept;
+
     /**
      * Invoke the registered callback
      * i.e., this method should be called when the chunk arrives its destination.
      */
     void invoke_callback() noexcept;
 
+    /**
+     * Write the trace of the chunk into the trace writer of its simulation, if any.
+     * i.e., this method should be called when the chunk arrives its destination.
+     */
     void dump_info() noexcept;
     
     int stall_count;
@@ -96,14 +172,24 @@ class Chunk {
     double last_bpns;
     DeviceId src_device_id;
     DeviceId dst_device_id; 
+
+    /// time the last packet of the chunk (fully) arrives at its current device
+    EventTime tail_arrival_time;
     
     private:
     /// size of the chunk
     ChunkSize chunk_size;
+
+    /// size of the packets the chunk is split into, 0 if sent whole
+    ChunkSize packet_size;
+
     int chunk_id;
 
+    /// virtual channel the chunk waits in
+    int virtual_channel;
+
     /// route of the chunk to its destination.
-    /// Route has the structure of [current device, next device, ..., dest device]
+    /// Route has the structure of [current device, next device, ..., dest device], from its cursor
     /// e.g., if a chunk starts from device 5, then reaches destination 3,
     /// the route would be e.g., [5, 1, 6, 2, 3]
     Route route;
@@ -114,11 +200,12 @@ class Chunk {
     /// argument of the callback
     CallbackArg callback_arg;
 
+    /// simulation of the device the chunk currently sits at
+    /// the topology (hence the simulation) outlives every chunk sent through it
+    SimulationContext* context;
+
     EventTime sent_time;
     EventTime arrival_time;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
-
-// 全局输出流变量
-extern std::ofstream& eventTrackerFileStream;
\ No newline at end of file
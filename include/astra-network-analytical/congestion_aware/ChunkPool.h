@@ -0,0 +1,127 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/MemoryPool.h"
+#include "common/Type.h"
+#include "congestion_aware/Type.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * ChunkPool allocates the chunks of a simulation out of a MemoryPool.
+ *
+ * A chunk created by the pool is still owned by a plain std::unique_ptr<Chunk>:
+ * each chunk is prefixed by a header pointing to its pool,
+ * so that destroying it (e.g., right after its callback is invoked at the destination)
+ * recycles the memory into the pool instead of releasing it to the heap.
+ * Hence the memory of a simulation stays at its peak number of in-flight chunks.
+ *
+ * Chunks may be created and destroyed by multiple threads (e.g., ParallelSimulation),
+ * so the pool is guarded by a spin lock.
+ */
+class ChunkPool {
+  public:
+    /**
+     * Constructor.
+     */
+    ChunkPool() noexcept;
+
+    ChunkPool(const ChunkPool&) = delete;
+    ChunkPool& operator=(const ChunkPool&) = delete;
+
+    /**
+     * Create a chunk out of the pool.
+     * Arguments are the same as the constructor of Chunk.
+     *
+     * @param chunk_size size of the chunk
+     * @param chunk_id id of the chunk
+     * @param route route of the chunk from its source to destination
+     * @param callback callback to be invoked when the chunk arrives destination
+     * @param callback_arg argument of the callback
+     * @return created chunk
+     */
+    [[nodiscard]] std::unique_ptr<Chunk> create_chunk(ChunkSize chunk_size,
+                                                      int chunk_id,
+                                                      Route route,
+                                                      Callback callback,
+                                                      CallbackArg callback_arg) noexcept;
+
+    /**
+     * Get the number of chunks created by the pool so far.
+     *
+     * @return number of created chunks
+     */
+    [[nodiscard]] uint64_t get_created_chunks_count() const noexcept;
+
+    /**
+     * Get the number of chunks created by the pool and not destroyed yet.
+     *
+     * @return number of live chunks
+     */
+    [[nodiscard]] uint64_t get_live_chunks_count() const noexcept;
+
+    /**
+     * Get the largest number of chunks that were alive at once.
+     *
+     * @return peak number of live chunks
+     */
+    [[nodiscard]] uint64_t get_peak_live_chunks_count() const noexcept;
+
+    /**
+     * Get the number of heap allocations made by the pool.
+     *
+     * @return number of heap allocations
+     */
+    [[nodiscard]] uint64_t get_heap_allocations_count() const noexcept;
+
+    /**
+     * Allocate the memory of a chunk created outside of any pool (e.g., std::make_unique<Chunk>).
+     *
+     * @param size size of the chunk
+     * @return memory of the chunk
+     */
+    [[nodiscard]] static void* allocate_unpooled(size_t size);
+
+    /**
+     * Release the memory of a chunk,
+     * recycling it into its pool if created by one, or to the heap otherwise.
+     *
+     * @param chunk_ptr memory of the chunk
+     */
+    static void release(void* chunk_ptr) noexcept;
+
+  private:
+    /// header prefixed to each chunk, keeping the chunk itself aligned
+    struct alignas(std::max_align_t) ChunkHeader {
+        /// pool the chunk is created by, nullptr if allocated from the heap
+        ChunkPool* pool;
+    };
+
+    /// memory of the chunks
+    MemoryPool memory_pool;
+
+    /// spin lock guarding memory_pool
+    mutable std::atomic_flag locked;
+
+    /**
+     * Acquire the spin lock.
+     */
+    void lock() const noexcept;
+
+    /**
+     * Release the spin lock.
+     */
+    void unlock() const noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,37 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/CollectiveDag.h"
+#include <memory>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * Construct the schedule of a collective among the first npus_count NPUs.
+ *
+ * Each NPU holds a buffer of the given size (per NPU, the input of a reduction or the output of a gather,
+ * and the data sent out of each NPU for all-to-all), split into pieces of size / npus_count.
+ * The buffer is further split into chunks_count slices,
+ * each scheduled independently so that the slices pipeline through the steps of the algorithm.
+ *
+ * @param type collective pattern
+ * @param algorithm algorithm implementing the collective
+ * @param npus_count number of NPUs taking part in the collective
+ * @param size size of the buffer of each NPU
+ * @param chunks_count number of slices the buffer is split into
+ * @return schedule of the collective
+ */
+[[nodiscard]] std::unique_ptr<CollectiveDag> construct_collective(CollectiveType type,
+                                                                  CollectiveAlgorithm algorithm,
+                                                                  int npus_count,
+                                                                  ChunkSize size,
+                                                                  int chunks_count = 1) noexcept;
+
+}  // namespace NetworkAnalyticalCongestionAware
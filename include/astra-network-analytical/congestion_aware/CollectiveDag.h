@@ -0,0 +1,157 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Topology.h"
+#include "congestion_aware/Type.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * CollectiveDag is a collective communication schedule,
+ * expressed as a dependency DAG of chunk sends between NPUs.
+ *
+ * A send is issued (as a chunk through Topology::send) once every send it depends on has arrived,
+ * so the schedule is driven by the completion callbacks of the chunks.
+ * The callback of the collective is invoked once every send has arrived.
+ *
+ * The DAG should outlive its run. It can be run again once finished.
+ */
+class CollectiveDag {
+  public:
+    /**
+     * Constructor.
+     */
+    CollectiveDag() noexcept;
+
+    CollectiveDag(const CollectiveDag&) = delete;
+    CollectiveDag& operator=(const CollectiveDag&) = delete;
+
+    /**
+     * Add a send of the given size from src to dest,
+     * to be issued once every send of the dependencies has arrived.
+     *
+     * @param src src NPU id
+     * @param dest dest NPU id
+     * @param size size of the send
+     * @param dependencies indices of the sends to wait for, added earlier
+     * @return index of the send
+     */
+    int add_send(DeviceId src, DeviceId dest, ChunkSize size, const std::vector<int>& dependencies = {}) noexcept;
+
+    /**
+     * Get the number of sends in the DAG.
+     *
+     * @return number of sends
+     */
+    [[nodiscard]] int get_sends_count() const noexcept;
+
+    /**
+     * Get the total number of bytes sent by the DAG.
+     *
+     * @return number of bytes
+     */
+    [[nodiscard]] uint64_t get_sent_bytes() const noexcept;
+
+    /**
+     * Get the length of the longest dependency chain of sends.
+     *
+     * @return number of sends along the critical path
+     */
+    [[nodiscard]] int get_depth() const noexcept;
+
+    /**
+     * Start issuing the sends through the topology.
+     * Chunks are created out of the pool of the simulation the topology belongs to.
+     *
+     * @param topology topology to send the chunks through
+     * @param callback callback to be invoked when every send has arrived
+     * @param callback_arg argument of the callback
+     */
+    void run(Topology* topology, Callback callback, CallbackArg callback_arg) noexcept;
+
+    /**
+     * Check if every send of the last run has arrived.
+     *
+     * @return true if finished, false otherwise
+     */
+    [[nodiscard]] bool finished() const noexcept;
+
+    /**
+     * Get the time the last run finished.
+     *
+     * @return finish time
+     */
+    [[nodiscard]] EventTime get_finish_time() const noexcept;
+
+  private:
+    /// send between two NPUs
+    struct Send {
+        /// DAG the send belongs to
+        CollectiveDag* dag;
+
+        /// index of the send
+        int index;
+
+        /// src NPU id
+        DeviceId src;
+
+        /// dest NPU id
+        DeviceId dest;
+
+        /// size of the send
+        ChunkSize size;
+
+        /// number of sends it depends on
+        int dependencies_count;
+
+        /// number of dependencies not arrived yet, during a run
+        int pending_dependencies_count;
+
+        /// indices of the sends depending on it
+        std::vector<int> dependents;
+    };
+
+    /// sends of the DAG
+    std::vector<Send> sends;
+
+    /// topology the DAG runs on, nullptr if not started
+    Topology* topology;
+
+    /// callback to be invoked when every send has arrived
+    Callback callback;
+
+    /// argument of the callback
+    CallbackArg callback_arg;
+
+    /// number of sends arrived during the last run
+    int arrived_sends_count;
+
+    /// time the last run finished
+    EventTime finish_time;
+
+    /**
+     * Callback to be invoked when a send arrives at its dest.
+     *
+     * @param send_ptr pointer to the send
+     */
+    static void send_arrived(void* send_ptr) noexcept;
+
+    /**
+     * Issue a send through the topology.
+     *
+     * @param send send to issue
+     */
+    void issue(Send& send) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -6,9 +6,10 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Type.h"
+#include "congestion_aware/SimulationContext.h"
 #include "congestion_aware/Type.h"
-#include <map>
 #include <memory>
+#include <vector>
 
 using namespace NetworkAnalytical;
 
@@ -19,13 +20,17 @@ namespace NetworkAnalyticalCongestionAware {
  * Device is usually an NPU or a switch.
  */
 class Device {
+    friend class LinkStore;
+
   public:
     /**
      * Constructor.
      *
      * @param id id of the device
+     * @param context simulation the device belongs to
+     * @param group_base_id base id of the topology the device belongs to
      */
-    explicit Device(DeviceId id, DeviceId group_base_id=0) noexcept;
+    Device(DeviceId id, std::shared_ptr<SimulationContext> context, DeviceId group_base_id = 0) noexcept;
 
     /**
      * Get id of the device.
@@ -34,6 +39,56 @@ class Device {
      */
     [[nodiscard]] DeviceId get_id() const noexcept;
 
+    /**
+     * Get the simulation the device belongs to.
+     *
+     * @return simulation context
+     */
+    [[nodiscard]] SimulationContext* get_simulation_context() const noexcept;
+
+    /**
+     * Move the device, along with its outgoing links, to another simulation context.
+     *
+     * @param context simulation the device belongs to
+     */
+    void set_simulation_context(std::shared_ptr<SimulationContext> context) noexcept;
+
+    /**
+     * Get the number of outgoing links (ports) of the device.
+     * Ports are only available once the links are moved into the LinkStore of the topology.
+     *
+     * @return number of ports
+     */
+    [[nodiscard]] int get_ports_count() const noexcept;
+
+    /**
+     * Get the device the given port is connected to.
+     * Ports are numbered in the increasing order of the connected device ids.
+     *
+     * @param port port index
+     * @return id of the connected device
+     */
+    [[nodiscard]] DeviceId get_neighbor(int port) const noexcept;
+
+    /**
+     * Get the outgoing link of the given port.
+     *
+     * @param port port index
+     * @return outgoing link
+     */
+    [[nodiscard]] Link* get_link(int port) const noexcept;
+
+    /**
+     * Get the port connected to another device.
+     * Takes constant time if the connected device ids are contiguous (e.g., switches),
+     * or a binary search over the ports otherwise.
+     * Sends don't look up ports, as the ports are resolved along with the routes.
+     *
+     * @param dest id of the connected device
+     * @return port index, -1 if not connected
+     */
+    [[nodiscard]] int get_port(DeviceId dest) const noexcept;
+
     /**
      * Initiate a chunk transmission.
      * You must invoke this method on the source device of the chunk.
@@ -44,6 +99,7 @@ class Device {
 
     /**
      * Connect a device to another device.
+     * Links can only be connected before the LinkStore of the topology is built.
      *
      * @param id id of the device to connect this device to
      * @param bandwidth bandwidth of the link
@@ -52,14 +108,61 @@ class Device {
      */
     void connect(DeviceId id, Bandwidth bandwidth, Latency latency, bool non_blocking) noexcept;
 
+    /**
+     * Connect a device the same way another device is connected (e.g., to replicate a building block),
+     * translating the ids of the connected devices.
+     * Links of either device can only be copied before the LinkStore of its topology is built.
+     *
+     * @param device device to copy the links of
+     * @param translate_id translates the id of a device connected to the given device into the id to connect to
+     */
+    template <typename TranslateId>
+    void connect_as(const Device& device, const TranslateId& translate_id) noexcept {
+        for (const auto& pending_link : device.pending_links) {
+            connect(translate_id(pending_link.dest), pending_link.bandwidth, pending_link.latency,
+                    pending_link.non_blocking);
+        }
+    }
+
   private:
     /// device Id
     DeviceId device_id;
     DeviceId GroupBaseId;
 
-    /// links to other nodes
-    /// map[dest node node_id] -> link
-    std::map<DeviceId, std::shared_ptr<Link>> links;
+    /// simulation the device belongs to
+    std::shared_ptr<SimulationContext> context;
+
+    /// link connected before the LinkStore is built
+    struct PendingLink {
+        DeviceId dest;
+        Bandwidth bandwidth;
+        Latency latency;
+        bool non_blocking;
+    };
+
+    /// links connected so far, moved into the LinkStore once it's built
+    std::vector<PendingLink> pending_links;
+
+    /// row of the device in the LinkStore: outgoing links, one per port
+    Link* links;
+
+    /// row of the device in the LinkStore: connected device id of each port, sorted
+    const DeviceId* neighbors;
+
+    /// number of ports, valid once bound to the LinkStore
+    int ports_count;
+
+    /// whether the connected device ids are contiguous, so that port = dest - neighbors[0]
+    bool contiguous_neighbors;
+
+    /**
+     * Bind the device to its row in the LinkStore.
+     *
+     * @param links outgoing links, one per port
+     * @param neighbors connected device id of each port, sorted
+     * @param ports_count number of ports
+     */
+    void bind_links(Link* links, const DeviceId* neighbors, int ports_count) noexcept;
 
     /**
      * Check if this device is connected to another device.
@@ -0,0 +1,159 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Topology.h"
+#include "congestion_aware/Type.h"
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * FlowSimulation is a flow-level (fluid) alternative to sending chunks hop by hop through Links.
+ *
+ * Each chunk sent is modeled as a flow occupying every link of its route at once.
+ * Flows share the bandwidth of blocking links max-min fairly,
+ * while a non-blocking link only caps the rate of each flow crossing it.
+ * Rates are recomputed only when flows start or finish,
+ * so a chunk costs a constant number of events regardless of its size and route length.
+ * Once all bytes of a flow are transmitted, the chunk arrives at its dest
+ * after the sum of the link latencies along its route, and its callback is invoked.
+ *
+ * Links are taken from the given topology (hence share their bandwidth and latency definitions),
+ * and events are scheduled to the simulation the topology belongs to.
+ * The flow simulation should outlive the simulation run.
+ */
+class FlowSimulation {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param topology topology to simulate flows on
+     */
+    explicit FlowSimulation(std::shared_ptr<Topology> topology) noexcept;
+
+    FlowSimulation(const FlowSimulation&) = delete;
+    FlowSimulation& operator=(const FlowSimulation&) = delete;
+
+    /**
+     * Start a flow carrying the chunk from its current device to its dest.
+     *
+     * @param chunk chunk to be transmitted
+     */
+    void send(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Get the number of flows being transmitted.
+     *
+     * @return number of active flows
+     */
+    [[nodiscard]] int get_active_flows_count() const noexcept;
+
+    /**
+     * Get the number of times the rates of the flows have been recomputed.
+     *
+     * @return number of rate updates
+     */
+    [[nodiscard]] uint64_t get_rate_updates_count() const noexcept;
+
+  private:
+    /// flow being transmitted
+    struct Flow {
+        /// chunk the flow carries
+        std::unique_ptr<Chunk> chunk;
+
+        /// blocking links along the route, as indices into link_capacities
+        std::vector<int> links;
+
+        /// maximum rate allowed by the non-blocking links along the route, in B/ns
+        double rate_cap;
+
+        /// sum of the link latencies along the route
+        EventTime latency;
+
+        /// bytes not transmitted yet
+        double remaining_bytes;
+
+        /// current rate in B/ns
+        double rate;
+    };
+
+    /// topology to simulate flows on
+    std::shared_ptr<Topology> topology;
+
+    /// simulation the topology belongs to
+    SimulationContext* context;
+
+    /// blocking link -> index into link_capacities
+    std::unordered_map<const Link*, int> link_indices;
+
+    /// bandwidth of each blocking link in B/ns
+    std::vector<double> link_capacities;
+
+    /// flows being transmitted
+    std::vector<Flow> active_flows;
+
+    /// flows sent but not started yet
+    std::vector<Flow> starting_flows;
+
+    /// time the progress of active flows was last accounted
+    EventTime last_update_time;
+
+    /// times updates are scheduled at
+    std::set<EventTime> scheduled_updates;
+
+    /// number of rate recomputations
+    uint64_t rate_updates_count;
+
+    /**
+     * Callback to be invoked when flows may start or finish.
+     *
+     * @param flow_simulation_ptr pointer to the flow simulation
+     */
+    static void update(void* flow_simulation_ptr) noexcept;
+
+    /**
+     * Callback to be invoked when a flow arrives at its dest.
+     *
+     * @param chunk_ptr pointer to the chunk the flow carried
+     */
+    static void flow_arrived(void* chunk_ptr) noexcept;
+
+    /**
+     * Account the progress of active flows, finish completed ones and start new ones,
+     * then recompute the rates and schedule the next update.
+     */
+    void process_update() noexcept;
+
+    /**
+     * Schedule an update at the given time, unless already scheduled.
+     *
+     * @param update_time time of the update
+     */
+    void schedule_update(EventTime update_time) noexcept;
+
+    /**
+     * Assign max-min fair rates to the active flows (progressive filling).
+     */
+    void compute_rates() noexcept;
+
+    /**
+     * Get the index of a blocking link, registering it on its first use.
+     *
+     * @param link blocking link
+     * @return index into link_capacities
+     */
+    [[nodiscard]] int get_link_index(const Link* link) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
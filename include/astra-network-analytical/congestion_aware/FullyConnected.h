@@ -33,13 +33,18 @@ class FullyConnected final : public BasicTopology {
      * @param bandwidth bandwidth of each link
      * @param latency latency of each link
      * @param base_id base id of the topology
+     * @param context simulation the topology belongs to
      */
-    FullyConnected(int npus_count, Bandwidth bandwidth, Latency latency, const int base_id) noexcept;
+    FullyConnected(int npus_count,
+                   Bandwidth bandwidth,
+                   Latency latency,
+                   const int base_id,
+                   std::shared_ptr<SimulationContext> context) noexcept;
 
     /**
-     * Implementation of route function in Topology.
+     * Implementation of compute_route function in Topology.
      */
-    [[nodiscard]] Route route(DeviceId src, DeviceId dest) const noexcept override;
+    [[nodiscard]] Route compute_route(DeviceId src, DeviceId dest) const noexcept override;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
@@ -17,8 +17,11 @@ namespace NetworkAnalyticalCongestionAware {
  * Construct a topology from a NetworkParser.
  *
  * @param network_parser NetworkParser to parse the network input file
+ * @param context simulation the topology belongs to,
+ *     nullptr to use the default context set by Topology::set_event_queue
  * @return pointer to the constructed topology
  */
-[[nodiscard]] std::shared_ptr<Topology> construct_topology(const NetworkParser& network_parser) noexcept;
+[[nodiscard]] std::shared_ptr<Topology> construct_topology(const NetworkParser& network_parser,
+                                                           std::shared_ptr<SimulationContext> context = nullptr) noexcept;
 
 }  // namespace NetworkAnalyticalCongestionAware
@@ -6,14 +6,48 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/EventQueue.h"
+#include "common/RingBuffer.h"
 #include "common/Type.h"
+#include "congestion_aware/LinkTelemetry.h"
+#include "congestion_aware/SimulationContext.h"
 #include "congestion_aware/Type.h"
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 using namespace NetworkAnalytical;
 
 namespace NetworkAnalyticalCongestionAware {
 
+/**
+ * Arbitration among the virtual channels of a link,
+ * deciding which pending chunk is served once the link becomes free.
+ */
+enum class VirtualChannelArbitration {
+    /// serve non-empty virtual channels in turn
+    RoundRobin,
+
+    /// serve the lowest-indexed non-empty virtual channel
+    Priority,
+};
+
+/**
+ * Queue occupancy statistics of a virtual channel.
+ */
+struct VirtualChannelStats {
+    /// number of chunks that had to wait in the queue
+    uint64_t enqueued_chunks_count;
+
+    /// number of chunks currently waiting
+    uint64_t occupancy;
+
+    /// largest number of chunks that waited at once
+    uint64_t peak_occupancy;
+
+    /// number of waiting chunks, averaged over the time since the simulation started
+    double average_occupancy;
+};
+
 /**
  * Link models physical links between two devices.
  */
@@ -29,11 +63,13 @@ class Link {
     static void link_become_free(void* link_ptr) noexcept;
 
     /**
-     * Set the event queue to be used by the link.
+     * Callback to be called when a chunk transmitted through a blocking link
+     * arrives at the next device, which is also when the link becomes free.
+     * Delivers the chunk (see Chunk::chunk_arrived_next_device), then frees the link (see link_become_free).
      *
-     * @param event_queue_ptr pointer to the event queue
+     * @param link_ptr pointer to the link that completed the transmission
      */
-    static void set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept;
+    static void transmission_complete(void* link_ptr) noexcept;
 
     /**
      * Constructor.
@@ -41,13 +77,85 @@ class Link {
      * @param bandwidth bandwidth of the link
      * @param latency latency of the link
      * @param non_blocking flag to indicate if the link is non-blocking
+     * @param context simulation the link belongs to
+     */
+    Link(Bandwidth bandwidth, Latency latency, bool non_blocking, std::shared_ptr<SimulationContext> context) noexcept;
+
+    /**
+     * Get the latency of the link.
+     *
+     * @return latency of the link in ns
+     */
+    [[nodiscard]] Latency get_latency() const noexcept;
+
+    /**
+     * Get the bandwidth of the link.
+     *
+     * @return bandwidth of the link in B/ns
+     */
+    [[nodiscard]] Bandwidth get_bandwidth_Bpns() const noexcept;
+
+    /**
+     * Check if the link is non-blocking,
+     * i.e., if it serves multiple chunks at once, each at the full bandwidth.
+     *
+     * @return true if the link is non-blocking, false otherwise
+     */
+    [[nodiscard]] bool is_non_blocking() const noexcept;
+
+    /**
+     * Move the link to another simulation context.
+     *
+     * @param context simulation the link belongs to
+     */
+    void set_simulation_context(std::shared_ptr<SimulationContext> context) noexcept;
+
+    /**
+     * Set the virtual channels of the link.
+     * Pending chunks wait in the queue of their virtual channel (see Chunk::set_virtual_channel),
+     * chunks of a virtual channel beyond the last one wait in the last one.
+     * Should be set while no chunk is pending.
+     *
+     * @param virtual_channels_count number of virtual channels
+     * @param arbitration arbitration among the virtual channels
+     */
+    void set_virtual_channels(int virtual_channels_count, VirtualChannelArbitration arbitration) noexcept;
+
+    /**
+     * Get the number of virtual channels of the link.
+     *
+     * @return number of virtual channels
      */
-    Link(Bandwidth bandwidth, Latency latency, bool non_blocking) noexcept;
+    [[nodiscard]] int get_virtual_channels_count() const noexcept;
+
+    /**
+     * Get the queue occupancy statistics of a virtual channel.
+     *
+     * @param virtual_channel index of the virtual channel
+     * @return queue occupancy statistics
+     */
+    [[nodiscard]] VirtualChannelStats get_virtual_channel_stats(int virtual_channel) const noexcept;
+
+    /**
+     * Sample the utilization of the link per each window of the given length.
+     * Ignored unless built with NETWORK_BACKEND_LINK_TELEMETRY.
+     *
+     * @param utilization_window length of a window, 0 not to sample
+     */
+    void set_utilization_window(EventTime utilization_window) noexcept;
+
+    /**
+     * Get the utilization and queueing statistics of the link.
+     * Every statistic is zero unless built with NETWORK_BACKEND_LINK_TELEMETRY.
+     *
+     * @return telemetry of the link
+     */
+    [[nodiscard]] LinkTelemetry get_telemetry() const noexcept;
 
     /**
      * Try to send a chunk through the link.
      * - If the link is free, service the chunk immediately.
-     * - If the link is busy, add the chunk to the pending chunks list.
+     * - If the link is busy, add the chunk to the queue of its virtual channel.
      *
      * @param chunk the chunk to be served by the link
      */
@@ -55,7 +163,7 @@ class Link {
 
     /**
      * Dequeue and try to send the first pending chunk
-     * in the pending chunks list.
+     * of the virtual channel chosen by the arbitration.
      */
     void process_pending_transmission() noexcept;
 
@@ -75,10 +183,10 @@ class Link {
      * Set the link as free.
      */
     void set_free() noexcept;
-    
-    /// event queue Link uses to schedule events
-    static std::shared_ptr<EventQueue> event_queue;
+
   private:
+    /// simulation the link belongs to, used to schedule events
+    std::shared_ptr<SimulationContext> context;
 
     /// bandwidth of the link in GB/s
     Bandwidth bandwidth;
@@ -89,8 +197,35 @@ class Link {
     /// latency of the link in ns
     Latency latency;
 
-    /// queue of pending chunks
-    std::list<std::unique_ptr<Chunk>> pending_chunks;
+    /// pending chunks and queue statistics of a virtual channel
+    struct VirtualChannel {
+        /// queue of pending chunks
+        RingBuffer<std::unique_ptr<Chunk>> pending_chunks;
+
+        /// number of chunks enqueued so far
+        uint64_t enqueued_chunks_count = 0;
+
+        /// largest number of chunks pending at once
+        uint64_t peak_occupancy = 0;
+
+        /// integral of the number of pending chunks over time
+        double occupancy_area = 0;
+
+        /// time occupancy_area was last accounted
+        EventTime last_update_time = 0;
+    };
+
+    /// virtual channels of the link
+    std::vector<VirtualChannel> virtual_channels;
+
+    /// arbitration among the virtual channels
+    VirtualChannelArbitration arbitration;
+
+    /// virtual channel to be examined first by round-robin arbitration
+    int next_virtual_channel;
+
+    /// number of pending chunks over all virtual channels
+    uint64_t pending_chunks_count;
 
     /// flag to indicate if the link is busy
     bool busy;
@@ -98,6 +233,12 @@ class Link {
     /// flag to indicate if the link is non-blocking
     bool non_blocking;
 
+    /// chunk being transmitted, awaiting transmission_complete
+    std::unique_ptr<Chunk> transmitting_chunk;
+
+    /// telemetry of the link, empty unless enabled
+    LinkTelemetryRecorder<link_telemetry_enabled> telemetry;
+
     /**
      * Compute the serialization delay of a chunk on the link.
      * i.e., serialization delay = (chunk size) / (link bandwidth)
@@ -125,6 +266,23 @@ class Link {
      * @param chunk chunk to be transmitted
      */
     void schedule_chunk_transmission(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Schedule the transmission of a chunk split into packets.
+     * The head packet reaches the next device after a single packet serialization delay (plus latency),
+     * while the link is occupied until the last packet is serialized.
+     *
+     * @param chunk chunk to be transmitted
+     */
+    void schedule_packets_transmission(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Account the occupancy of a virtual channel up to the current time,
+     * before its queue length changes.
+     *
+     * @param virtual_channel virtual channel to account
+     */
+    void account_occupancy(VirtualChannel& virtual_channel) noexcept;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,68 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Link.h"
+#include "congestion_aware/Type.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * LinkStore holds every link of a topology in compressed sparse row (CSR) form.
+ *
+ * Outgoing links of the i-th device occupy [offsets[i], offsets[i + 1]) of the contiguous link array,
+ * sorted by dest device id, so that each link is addressed by its (device, port) pair.
+ * Devices are bound to their own rows once the store is built,
+ * after which the store is immutable (except for the state of each link)
+ * and links never move.
+ */
+class LinkStore {
+  public:
+    /**
+     * Constructor.
+     * Move the links connected so far by each device into the store,
+     * and bind each device to its row.
+     *
+     * @param devices devices of the topology
+     */
+    explicit LinkStore(const std::vector<std::shared_ptr<Device>>& devices) noexcept;
+
+    LinkStore(const LinkStore& link_store) = delete;
+    LinkStore& operator=(const LinkStore& link_store) = delete;
+
+    /**
+     * Get the number of links in the store.
+     *
+     * @return number of links
+     */
+    [[nodiscard]] size_t get_links_count() const noexcept;
+
+    /**
+     * Get a link by its index in the store.
+     *
+     * @param index index of the link, in (device, port) order
+     * @return link
+     */
+    [[nodiscard]] Link& get_link(size_t index) noexcept;
+
+  private:
+    /// outgoing links of the i-th device: [offsets[i], offsets[i + 1])
+    std::vector<uint64_t> offsets;
+
+    /// dest device id of each link
+    std::vector<DeviceId> neighbors;
+
+    /// link instances, in (device, port) order
+    std::vector<Link> links;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
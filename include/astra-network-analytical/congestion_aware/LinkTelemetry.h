@@ -0,0 +1,174 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Type.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/// whether links collect telemetry, set by the NETWORK_BACKEND_LINK_TELEMETRY build option
+#ifdef NETWORK_BACKEND_LINK_TELEMETRY
+constexpr auto link_telemetry_enabled = true;
+#else
+constexpr auto link_telemetry_enabled = false;
+#endif
+
+/**
+ * Utilization and queueing statistics of a link.
+ */
+struct LinkTelemetry {
+    /// number of bytes transmitted through the link
+    uint64_t carried_bytes = 0;
+
+    /// total time the link was occupied by transmissions
+    EventTime busy_time = 0;
+
+    /// number of chunks that had to wait because the link was busy
+    uint64_t stalls_count = 0;
+
+    /// largest number of chunks pending at once, over all virtual channels
+    uint64_t peak_pending_chunks_count = 0;
+
+    /// number of pending chunks, averaged over the time since the simulation started
+    double average_pending_chunks_count = 0;
+
+    /// length of a utilization window, 0 if utilization isn't sampled
+    EventTime utilization_window = 0;
+
+    /// fraction of each window the link was occupied
+    /// (may exceed 1 for non-blocking links, which serve multiple chunks at once)
+    std::vector<double> utilization_samples;
+};
+
+/**
+ * LinkTelemetryRecorder collects the telemetry of a link.
+ * Links hold a LinkTelemetryRecorder<link_telemetry_enabled>,
+ * so that the disabled recorder compiles down to nothing.
+ *
+ * @tparam enabled true to collect telemetry, false otherwise
+ */
+template <bool enabled> class LinkTelemetryRecorder;
+
+/**
+ * Disabled recorder, ignoring every record.
+ */
+template <> class LinkTelemetryRecorder<false> {
+  public:
+    void set_utilization_window(EventTime) noexcept {}
+
+    void record_transmission(ChunkSize, EventTime, EventTime) noexcept {}
+
+    void record_stall() noexcept {}
+
+    void record_pending_chunks(uint64_t, EventTime) noexcept {}
+
+    [[nodiscard]] LinkTelemetry get_telemetry(EventTime) const noexcept {
+        return LinkTelemetry();
+    }
+};
+
+/**
+ * Enabled recorder.
+ */
+template <> class LinkTelemetryRecorder<true> {
+  public:
+    /**
+     * Sample the utilization per each window of the given length.
+     * Should be set before any chunk is sent.
+     *
+     * @param utilization_window length of a window, 0 not to sample
+     */
+    void set_utilization_window(const EventTime utilization_window) noexcept {
+        telemetry.utilization_window = utilization_window;
+        telemetry.utilization_samples.clear();
+    }
+
+    /**
+     * Record a transmission occupying the link during [begin_time, end_time).
+     *
+     * @param chunk_size size of the transmitted chunk
+     * @param begin_time time the transmission starts
+     * @param end_time time the link becomes free
+     */
+    void record_transmission(const ChunkSize chunk_size, const EventTime begin_time, const EventTime end_time) noexcept {
+        telemetry.carried_bytes += chunk_size;
+        telemetry.busy_time += end_time - begin_time;
+
+        const auto window = telemetry.utilization_window;
+        if (window == 0 || end_time <= begin_time) {
+            return;
+        }
+
+        // spread the busy time over the windows it overlaps
+        auto& samples = telemetry.utilization_samples;
+        const auto last_window = static_cast<size_t>((end_time - 1) / window);
+        if (samples.size() <= last_window) {
+            samples.resize(last_window + 1, 0);
+        }
+        for (auto i = static_cast<size_t>(begin_time / window); i <= last_window; i++) {
+            const auto window_begin = i * window;
+            const auto overlap = std::min(end_time, window_begin + window) - std::max(begin_time, window_begin);
+            samples[i] += static_cast<double>(overlap) / window;
+        }
+    }
+
+    /**
+     * Record a chunk waiting because the link is busy.
+     */
+    void record_stall() noexcept {
+        telemetry.stalls_count++;
+    }
+
+    /**
+     * Record a change of the number of pending chunks.
+     *
+     * @param pending_chunks_count number of pending chunks from now on
+     * @param current_time current time
+     */
+    void record_pending_chunks(const uint64_t pending_chunks_count, const EventTime current_time) noexcept {
+        pending_chunks_area += static_cast<double>(this->pending_chunks_count) * (current_time - last_update_time);
+        last_update_time = current_time;
+        this->pending_chunks_count = pending_chunks_count;
+        telemetry.peak_pending_chunks_count = std::max(telemetry.peak_pending_chunks_count, pending_chunks_count);
+    }
+
+    /**
+     * Get the telemetry collected so far.
+     *
+     * @param current_time current time
+     * @return telemetry of the link
+     */
+    [[nodiscard]] LinkTelemetry get_telemetry(const EventTime current_time) const noexcept {
+        auto result = telemetry;
+
+        // account the pending chunks since the last change
+        const auto area =
+            pending_chunks_area + static_cast<double>(pending_chunks_count) * (current_time - last_update_time);
+        result.average_pending_chunks_count = (current_time > 0) ? area / current_time : 0;
+        return result;
+    }
+
+  private:
+    /// telemetry collected so far, except the average number of pending chunks
+    LinkTelemetry telemetry;
+
+    /// number of pending chunks
+    uint64_t pending_chunks_count = 0;
+
+    /// integral of the number of pending chunks over time
+    double pending_chunks_area = 0;
+
+    /// time pending_chunks_area was last accounted
+    EventTime last_update_time = 0;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
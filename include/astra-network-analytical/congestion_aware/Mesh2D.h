@@ -36,13 +36,18 @@ class Mesh2D final : public BasicTopology {
      * @param bandwidth bandwidth of link
      * @param latency latency of link
      * @param base_id base id of the topology
+     * @param context simulation the topology belongs to
      */
-    Mesh2D(int npus_count, Bandwidth bandwidth, Latency latency, const int base_id) noexcept;
+    Mesh2D(int npus_count,
+           Bandwidth bandwidth,
+           Latency latency,
+           const int base_id,
+           std::shared_ptr<SimulationContext> context) noexcept;
 
     /**
-     * Implementation of route function in Topology.
+     * Implementation of compute_route function in Topology.
      */
-    [[nodiscard]] Route route(DeviceId src, DeviceId dest) const noexcept override;
+    [[nodiscard]] Route compute_route(DeviceId src, DeviceId dest) const noexcept override;
 
   private:
     int col_size; // column size of the 2D array
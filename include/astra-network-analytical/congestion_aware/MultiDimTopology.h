@@ -8,7 +8,9 @@ LICENSE file in the root directory of this source tree.
 #include "common/Type.h"
 #include "congestion_aware/BasicTopology.h"
 #include "congestion_aware/Topology.h"
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 using namespace NetworkAnalytical;
 
@@ -17,20 +19,45 @@ namespace NetworkAnalyticalCongestionAware {
 /**
  * MultiDimTopology implements multi-dimensional network topologies
  * which can be constructed by stacking up multiple BasicTopology instances.
+ *
+ * NPUs are addressed by strides: if the topology size is [2, 8, 4],
+ * NPU 47 is at [47 % 2, (47 / 2) % 8, 47 / 16] = [1, 7, 2].
+ * The building block of each dimension is replicated per each group of NPUs along the dimension
+ * (i.e., the NPUs whose addresses differ in that dimension only),
+ * and the switches of the replicas are laid out after the NPUs, dimension by dimension.
+ *
+ * VirtualSwitch and SpinalSwitch dimensions build a switch hierarchy instead:
+ * a SpinalSwitch dimension of size n has n leaf switches per each group,
+ * each connecting every NPU below it (i.e., of the same address in the dimension and above),
+ * and a spinal switch connecting the leaf switches.
+ * VirtualSwitch dimensions have no links of their own, and are reached through the leaf switches above them.
+ *
+ * Chunks are routed dimension by dimension, from the last dimension to the first.
+ * Routes within each building block are tabulated as the dimensions are connected,
+ * so that routes can be computed by multiple threads at once (e.g., by a RouteCache).
  */
 class MultiDimTopology : public Topology {
   public:
     /**
      * Constructor.
+     *
+     * @param context simulation the topology belongs to
      */
-    MultiDimTopology() noexcept;
+    explicit MultiDimTopology(std::shared_ptr<SimulationContext> context) noexcept;
 
     /**
      * Add a dimension to the multi-dimensional topology.
      *
-     * @param topology BasicTopology instance to be added.
+     * @param topology building block of the dimension, constructed with base id 0,
+     *     replicated per each group of NPUs along the dimension
      */
-    void append_dimension(std::vector<std::unique_ptr<BasicTopology>> topologies) noexcept;
+    void append_dimension(std::unique_ptr<BasicTopology> topology) noexcept;
+
+    /**
+     * Instantiate the devices and connect the replicas of the building block of every dimension.
+     * Should be called once, after every dimension is appended.
+     */
+    void connect_dimensions() noexcept;
 
     /**
      * Route a chunk from src to dest.
@@ -39,45 +66,117 @@ class MultiDimTopology : public Topology {
      * @param dest dest NPU ID
      * @return route information
      */
-    [[nodiscard]] Route route(DeviceId src, DeviceId dest) const noexcept;
-    
-    void connect_dimensions(const int dim1, const int dim2) noexcept;
-  
-    std::map<int, int> device_2_father_device_map;
-    int npu_counts;
-    int real_swtich_count;
+    [[nodiscard]] Route compute_route(DeviceId src, DeviceId dest) const noexcept override;
 
   private:
-    /// Each NPU ID can be broken down into multiple dimensions.
-    /// for example, if the topology size is [2, 8, 4] and the NPU ID is 31,
-    /// then the NPU ID can be broken down into [1, 7, 1].
-    using MultiDimAddress = std::vector<DeviceId>;
+    /// building block per dimension, replicated per each group of NPUs along the dimension
+    std::vector<std::unique_ptr<BasicTopology>> topology_per_dim;
+
+    /// difference of the ids of NPUs adjacent along each dimension
+    std::vector<DeviceId> stride_per_dim;
+
+    /// id of the first switch of each dimension
+    std::vector<DeviceId> switch_base_id_per_dim;
+
+    /// number of switches per each replica of the building block of each dimension
+    std::vector<int> switches_count_per_dim;
+
+    /// dimension whose leaf switches connect the NPUs, per each VirtualSwitch dimension (-1 for the others)
+    std::vector<int> leaf_dim_per_dim;
+
+    /// largest building block whose routes are tabulated
+    static constexpr int max_local_route_table_npus_count = 256;
+
+    /// routes of every (src, dest) pair of a building block, excluding src, in local device ids
+    struct LocalRouteTable {
+        /// device ids of every route, concatenated in (src, dest) order
+        std::vector<DeviceId> route_devices;
 
-    /// BasicTopology instances per dimension.
-    std::vector<std::vector<std::unique_ptr<BasicTopology>>> topology_per_dim;
+        /// route of pair (src, dest) is route_devices[offsets[p], offsets[p + 1]), p = src * npus_count + dest
+        std::vector<uint32_t> offsets;
+    };
+
+    /// route table per dimension, built once the dimensions are connected and read-only afterwards
+    /// (empty for switch hierarchies and for building blocks too large to tabulate)
+    std::vector<LocalRouteTable> local_route_table_per_dim;
 
     /**
-     * Translate the NPU ID into a multi-dimensional address.
+     * Get the address of an NPU in a dimension.
      *
      * @param npu_id id of the NPU
-     * @return the same NPU in multi-dimensional address representation
+     * @param dim dimension
+     * @return address of the NPU in the dimension
      */
-    [[nodiscard]] MultiDimAddress translate_address(DeviceId npu_id) const noexcept;
+    [[nodiscard]] int get_address(DeviceId npu_id, int dim) const noexcept;
 
     /**
-     * Given src and dest address in multi-dimensional form,
-     * return the dimension where the transfer should happen.
-     * i.e., the dimension where the src and dest addresses differ.
+     * Get the NPU whose addresses are of dest up to the given dimension, and of src above.
      *
-     * @param src_address src NPU ID in multi-dimensional form
-     * @param dest_address dest NPU ID in multi-dimensional form
-     * @return the dimension where the transfer should happen
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @param dim last dimension to take the address of dest
+     * @return id of the NPU
      */
-    [[nodiscard]] int get_dim_to_transfer(const MultiDimAddress& src_address,
-                                          const MultiDimAddress& dest_address) const noexcept;
+    [[nodiscard]] DeviceId replace_lower_addresses(DeviceId src, DeviceId dest, int dim) const noexcept;
 
-    int leaf_nodes_count;
+    /**
+     * Get the replica of the building block of a dimension an NPU belongs to.
+     * For VirtualSwitch and SpinalSwitch dimensions, the NPUs below a replica belong to it.
+     *
+     * @param npu_id id of the NPU
+     * @param dim dimension
+     * @return index of the replica
+     */
+    [[nodiscard]] int get_replica_index(DeviceId npu_id, int dim) const noexcept;
 
+    /**
+     * Get the NPU of address 0 in a replica of the building block of a dimension.
+     *
+     * @param replica_index index of the replica
+     * @param dim dimension
+     * @return id of the NPU
+     */
+    [[nodiscard]] DeviceId get_replica_base_id(int replica_index, int dim) const noexcept;
+
+    /**
+     * Get the number of replicas of the building block of a dimension.
+     *
+     * @param dim dimension
+     * @return number of replicas
+     */
+    [[nodiscard]] int get_replicas_count(int dim) const noexcept;
+
+    /**
+     * Translate the id of a device of the building block of a dimension into the id of the device in a replica.
+     *
+     * @param local_id id of the device in the building block
+     * @param dim dimension
+     * @param replica_index index of the replica
+     * @param replica_base_id id of the NPU of address 0 in the replica
+     * @return id of the device in the topology
+     */
+    [[nodiscard]] DeviceId translate_local_id(DeviceId local_id,
+                                              int dim,
+                                              int replica_index,
+                                              DeviceId replica_base_id) const noexcept;
+
+    /**
+     * Append the route from src to dest within the replica of the building block of a dimension they belong to,
+     * excluding src itself.
+     *
+     * @param route route to append to
+     * @param src src NPU ID
+     * @param dest dest NPU ID, whose address differs from src in the dimension only
+     * @param dim dimension
+     */
+    void append_route_in_dim(Route& route, DeviceId src, DeviceId dest, int dim) const noexcept;
+
+    /**
+     * Tabulate the routes of the building block of a dimension.
+     *
+     * @param dim dimension
+     */
+    void build_local_route_table(int dim) noexcept;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,153 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Topology.h"
+#include "congestion_aware/Type.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+class Partition;
+
+/**
+ * ParallelSimulation runs a congestion-aware simulation
+ * as a conservative parallel discrete-event simulation (YAWNS-style).
+ *
+ * Devices of the topology are split into partitions, each with its own event queue and thread.
+ * Partitions are cut along links of high latency,
+ * and the minimum latency of links crossing partitions is used as the lookahead:
+ * partitions process events of the window [T, T + lookahead) independently,
+ * where T is the earliest pending event time, and exchange cross-partition events in between windows.
+ *
+ * Events of the same time are processed in exactly the order the sequential EventQueue would,
+ * so every chunk (hence the simulation) finishes at a bit-identical time.
+ * Each event is keyed by (time of its parent event, rank of its parent event, index among its siblings),
+ * and parent events are ranked among the events of the same time at every window boundary.
+ * Times are ranked independently, so partition threads rank them in parallel.
+ *
+ * Usage: construct the topology, wrap it with a ParallelSimulation,
+ * send the chunks through the topology, and run().
+ * As callbacks of arrived chunks are invoked from partition threads,
+ * they should be thread-safe and shouldn't send new chunks. Chunk traces are not dumped.
+ */
+class ParallelSimulation {
+  public:
+    /**
+     * Constructor.
+     * Moves every device of the topology to its partition.
+     *
+     * @param topology topology to simulate
+     * @param threads_count maximum number of partitions (hence threads) to use
+     */
+    ParallelSimulation(std::shared_ptr<Topology> topology, int threads_count) noexcept;
+
+    /**
+     * Destructor.
+     */
+    ~ParallelSimulation() noexcept;
+
+    ParallelSimulation(const ParallelSimulation&) = delete;
+    ParallelSimulation& operator=(const ParallelSimulation&) = delete;
+
+    /**
+     * Run the simulation until every partition runs out of events.
+     */
+    void run() noexcept;
+
+    /**
+     * Get the number of partitions.
+     *
+     * @return number of partitions
+     */
+    [[nodiscard]] int get_partitions_count() const noexcept;
+
+    /**
+     * Get the partition a device belongs to.
+     *
+     * @param device_id id of the device
+     * @return partition index of the device
+     */
+    [[nodiscard]] int get_partition(DeviceId device_id) const noexcept;
+
+    /**
+     * Get the lookahead, i.e., the length of each synchronization window.
+     *
+     * @return lookahead in ns
+     */
+    [[nodiscard]] EventTime get_lookahead() const noexcept;
+
+    /**
+     * Get the current time, i.e., the time of the last processed event.
+     *
+     * @return current time
+     */
+    [[nodiscard]] EventTime get_current_time() const noexcept;
+
+    /**
+     * Get the number of processed events.
+     *
+     * @return number of processed events
+     */
+    [[nodiscard]] uint64_t get_events_count() const noexcept;
+
+    /**
+     * Get the number of synchronization windows run so far.
+     *
+     * @return number of windows
+     */
+    [[nodiscard]] uint64_t get_windows_count() const noexcept;
+
+  private:
+    /// topology being simulated
+    std::shared_ptr<Topology> topology;
+
+    /// partition index per each device
+    std::vector<int> device_partition;
+
+    /// partitions of the simulation
+    std::vector<std::unique_ptr<Partition>> partitions;
+
+    /// minimum arrival delay of cross-partition chunks
+    EventTime lookahead;
+
+    /// number of windows run so far
+    uint64_t windows_count;
+
+    /// number of events scheduled from outside of the simulation so far, e.g., by sending chunks
+    uint64_t roots_count;
+
+    /**
+     * Split devices into at most threads_count partitions
+     * and compute the lookahead.
+     *
+     * @param threads_count maximum number of partitions
+     */
+    void partition_devices(int threads_count) noexcept;
+
+    /**
+     * Get the earliest pending event time over all partitions.
+     *
+     * @return earliest pending event time
+     */
+    [[nodiscard]] EventTime get_next_event_time() const noexcept;
+
+    /**
+     * Rank the events processed during the last window, in the order the sequential engine would process them.
+     * Called by every partition thread, each ranking the events of a disjoint set of times.
+     *
+     * @param index index of the partition whose thread is ranking
+     * @param window_start start of the last window
+     */
+    void rank_processed_events(int index, EventTime window_start) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -39,13 +39,19 @@ class Ring final : public BasicTopology {
      * @param latency latency of link
      * @param bidirectional true if ring is bidirectional, false otherwise
      * @param base_id base id of the topology
+     * @param context simulation the topology belongs to
      */
-    Ring(int npus_count, Bandwidth bandwidth, Latency latency, bool bidirectional = true, const int base_id=0) noexcept;
+    Ring(int npus_count,
+         Bandwidth bandwidth,
+         Latency latency,
+         bool bidirectional,
+         const int base_id,
+         std::shared_ptr<SimulationContext> context) noexcept;
 
     /**
-     * Implementation of route function in Topology.
+     * Implementation of compute_route function in Topology.
      */
-    [[nodiscard]] Route route(DeviceId src, DeviceId dest) const noexcept override;
+    [[nodiscard]] Route compute_route(DeviceId src, DeviceId dest) const noexcept override;
 
   private:
     /// true if the ring is bidirectional, false otherwise
@@ -0,0 +1,191 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "congestion_aware/Type.h"
+#include <cstdint>
+#include <memory>
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * Route is the sequence of devices a chunk traverses,
+ * including the src and dest devices themselves,
+ * along with a cursor pointing to the device the chunk currently sits at.
+ *
+ * Devices are kept as plain pointers, inline for short routes,
+ * so following a route neither allocates nor touches reference counts.
+ * The topology owns the devices, and outlives every route constructed out of it.
+ *
+ * Once the links of the devices are bound, the port of each device connected to the following device
+ * is resolved once per route, so that sending through the route never looks up a port.
+ */
+class Route {
+  public:
+    /// number of devices stored inline, without heap allocation
+    static constexpr uint32_t inline_capacity = 8;
+
+    /**
+     * Constructor.
+     */
+    Route() noexcept;
+
+    Route(const Route& route) noexcept;
+    Route(Route&& route) noexcept;
+    Route& operator=(const Route& route) noexcept;
+    Route& operator=(Route&& route) noexcept;
+
+    /**
+     * Append a device at the end of the route.
+     *
+     * @param device device to append
+     */
+    void push_back(Device* device) noexcept;
+
+    /**
+     * Append a device at the end of the route.
+     *
+     * @param device device to append
+     */
+    void push_back(const std::shared_ptr<Device>& device) noexcept;
+
+    /**
+     * Get the device the cursor points to.
+     *
+     * @return current device
+     */
+    [[nodiscard]] Device* front() const noexcept;
+
+    /**
+     * Get the device following the current one.
+     *
+     * @return next device
+     */
+    [[nodiscard]] Device* next() const noexcept;
+
+    /**
+     * Get the port of the current device connected to the next device.
+     * Ports should have been resolved.
+     *
+     * @return port index
+     */
+    [[nodiscard]] int next_port() const noexcept;
+
+    /**
+     * Resolve the port of each device connected to the following device.
+     * The links of the devices should have been bound to the LinkStore.
+     */
+    void resolve_ports() noexcept;
+
+    /**
+     * Set the port of each device connected to the following device, resolved beforehand (e.g., by a RouteCache).
+     *
+     * @param ports port of each device, from the first device of the route to the one before the dest
+     */
+    void set_ports(const int32_t* ports) noexcept;
+
+    /**
+     * Check if the ports of the route are resolved.
+     *
+     * @return true if the ports are resolved, false otherwise
+     */
+    [[nodiscard]] bool has_ports() const noexcept;
+
+    /**
+     * Get the last device of the route.
+     *
+     * @return dest device
+     */
+    [[nodiscard]] Device* back() const noexcept;
+
+    /**
+     * Move the cursor to the next device.
+     */
+    void advance() noexcept;
+
+    /**
+     * Get the number of devices from the current one to the dest.
+     *
+     * @return number of remaining devices
+     */
+    [[nodiscard]] size_t size() const noexcept;
+
+    /**
+     * Check if no device is remaining.
+     *
+     * @return true if the route is empty, false otherwise
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * Iterate from the current device to the dest.
+     *
+     * @return iterator to the current device
+     */
+    [[nodiscard]] Device* const* begin() const noexcept;
+
+    /**
+     * Iterate from the current device to the dest.
+     *
+     * @return iterator past the dest device
+     */
+    [[nodiscard]] Device* const* end() const noexcept;
+
+  private:
+    /// devices of a short route
+    Device* inline_devices[inline_capacity];
+
+    /// devices of a route longer than inline_capacity
+    std::unique_ptr<Device*[]> heap_devices;
+
+    /// port of each device connected to the following device, of a short route
+    int32_t inline_ports[inline_capacity];
+
+    /// port of each device connected to the following device, of a route longer than inline_capacity
+    std::unique_ptr<int32_t[]> heap_ports;
+
+    /// whether the ports are resolved
+    bool ports_resolved;
+
+    /// number of devices in the route
+    uint32_t devices_count;
+
+    /// number of devices the route can hold without reallocation
+    uint32_t capacity;
+
+    /// index of the current device
+    uint32_t cursor;
+
+    /**
+     * Get the storage of the devices.
+     *
+     * @return pointer to the first device
+     */
+    [[nodiscard]] Device* const* data() const noexcept;
+
+    /**
+     * Get the storage of the ports.
+     *
+     * @return pointer to the port of the first device
+     */
+    [[nodiscard]] int32_t* ports_data() noexcept;
+
+    /**
+     * Get the storage of the ports.
+     *
+     * @return pointer to the port of the first device
+     */
+    [[nodiscard]] const int32_t* ports_data() const noexcept;
+
+    /**
+     * Copy the devices of another route.
+     *
+     * @param route route to copy
+     */
+    void copy_from(const Route& route) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,168 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Type.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+class Topology;
+
+/**
+ * RouteCache memoizes the NPU-to-NPU routes of a topology.
+ *
+ * On the first lookup, the routes of every (src, dest) pair are computed (in parallel if requested)
+ * and stored as a single contiguous array of device ids, indexed by per-pair offsets.
+ * The routes are computed twice, first to size the table and then to fill it in place,
+ * so that building the table never takes more memory than the table itself.
+ * Once the links of the topology are bound, the ports along every route in the table are resolved at once,
+ * and handed out along with the routes.
+ * If the table doesn't fit into the memory limit, the cache falls back to
+ * keeping the most recently used routes only, evicting the least recently used ones.
+ *
+ * The cache isn't thread-safe: routes should be looked up by a single thread at a time.
+ */
+class RouteCache {
+  public:
+    /// default memory limit of a route cache, in bytes
+    static constexpr size_t default_memory_limit = size_t(256) << 20;
+
+    /**
+     * Constructor.
+     *
+     * @param topology topology to cache the routes of
+     * @param memory_limit maximum memory to be used by the cached routes, in bytes
+     * @param threads_count number of threads used to build the route table
+     */
+    RouteCache(const Topology* topology, size_t memory_limit, int threads_count) noexcept;
+
+    /**
+     * Get the route from src to dest.
+     *
+     * @param src src NPU id
+     * @param dest dest NPU id
+     * @return route from src NPU to dest NPU
+     */
+    [[nodiscard]] Route route(DeviceId src, DeviceId dest) noexcept;
+
+    /**
+     * Check whether the routes of every pair are stored in the table,
+     * as opposed to falling back to the least-recently-used cache.
+     *
+     * @return true if the route table is built
+     */
+    [[nodiscard]] bool is_table_built() const noexcept;
+
+    /**
+     * Get the memory used by the cached routes.
+     *
+     * @return memory usage in bytes
+     */
+    [[nodiscard]] size_t get_memory_usage() const noexcept;
+
+  private:
+    /// cached route of a (src, dest) pair, in the least-recently-used cache
+    using CachedRoute = std::pair<uint64_t, std::vector<DeviceId>>;
+
+    /// topology to cache the routes of
+    const Topology* topology;
+
+    /// maximum memory to be used by the cached routes, in bytes
+    size_t memory_limit;
+
+    /// number of threads used to build the route table
+    int threads_count;
+
+    /// number of NPUs in the topology
+    int npus_count;
+
+    /// whether the cache has been initialized by the first lookup
+    bool initialized;
+
+    /// whether the route table is built
+    bool table_built;
+
+    /// whether the ports of the route table are resolved
+    bool table_ports_resolved;
+
+    /// device instances indexed by device id
+    std::vector<std::shared_ptr<Device>> devices;
+
+    /// route table: device ids of every route, concatenated in (src, dest) order
+    std::vector<DeviceId> route_devices;
+
+    /// route table: route of pair (src, dest) is route_devices[offsets[p], offsets[p + 1]), p = src * npus_count + dest
+    std::vector<uint64_t> offsets;
+
+    /// route table: port of each device in route_devices connected to the following device (-1 for dests)
+    std::vector<int32_t> route_ports;
+
+    /// least-recently-used cache: cached routes, the most recently used first
+    std::list<CachedRoute> recent_routes;
+
+    /// least-recently-used cache: (src, dest) pair -> cached route
+    std::unordered_map<uint64_t, std::list<CachedRoute>::iterator> recent_routes_index;
+
+    /// least-recently-used cache: memory used by the cached routes, in bytes
+    size_t recent_routes_memory;
+
+    /**
+     * Index the devices and try building the route table.
+     */
+    void initialize() noexcept;
+
+    /**
+     * Compute the routes of every pair into the route table.
+     *
+     * @return true if the table fits into the memory limit, false otherwise
+     */
+    bool build_table() noexcept;
+
+    /**
+     * Compute the device ids of the route from src to dest.
+     *
+     * @param src src NPU id
+     * @param dest dest NPU id
+     * @param route_devices vector to append the device ids to
+     */
+    void compute_route_devices(DeviceId src, DeviceId dest, std::vector<DeviceId>& route_devices) const noexcept;
+
+    /**
+     * Resolve the ports along every route in the table.
+     * The links of the topology should have been bound to the LinkStore.
+     */
+    void resolve_table_ports() noexcept;
+
+    /**
+     * Construct a Route out of device ids.
+     *
+     * @param begin first device id of the route
+     * @param end one past the last device id of the route
+     * @param ports port of each device connected to the following device, nullptr if not resolved
+     * @return route
+     */
+    [[nodiscard]] Route to_route(const DeviceId* begin, const DeviceId* end, const int32_t* ports) const noexcept;
+
+    /**
+     * Get the memory used by a cached route in the least-recently-used cache.
+     *
+     * @param route_devices device ids of the route
+     * @return memory usage in bytes
+     */
+    [[nodiscard]] static size_t get_memory_usage(const std::vector<DeviceId>& route_devices) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,119 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/ChromeTraceWriter.h"
+#include "congestion_aware/ChunkPool.h"
+#include "congestion_aware/TraceWriter.h"
+#include <memory>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * SimulationContext holds the per-simulation state
+ * shared by a Topology and its Devices, Links, and Chunks:
+ * the event queue, the pool chunks are allocated from, and the sink of chunk traces.
+ *
+ * Simulations built on different contexts share no mutable state,
+ * so they can run concurrently on different threads.
+ *
+ * Time and scheduling are virtual, so that an engine other than
+ * a single EventQueue (e.g., ParallelSimulation) can drive the same network components.
+ */
+class SimulationContext {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param event_queue event queue of the simulation
+     * @param trace_writer sink of chunk traces, nullptr to disable tracing
+     */
+    explicit SimulationContext(std::shared_ptr<EventQueue> event_queue,
+                               std::shared_ptr<TraceWriter> trace_writer = nullptr) noexcept;
+
+    /**
+     * Destructor.
+     */
+    virtual ~SimulationContext() noexcept = default;
+
+    /**
+     * Get the event queue of the simulation.
+     *
+     * @return event queue, nullptr if the simulation isn't driven by an EventQueue
+     */
+    [[nodiscard]] EventQueue* get_event_queue() const noexcept;
+
+    /**
+     * Get the current time of the simulation.
+     *
+     * @return current event time
+     */
+    [[nodiscard]] virtual EventTime get_current_time() const noexcept;
+
+    /**
+     * Schedule an event to the event queue of the simulation.
+     *
+     * @param event_time time of event
+     * @param callback callback function pointer
+     * @param callback_arg argument of the callback function
+     */
+    virtual void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) const noexcept;
+
+    /**
+     * Get the pool to create the chunks of the simulation out of.
+     *
+     * @return chunk pool
+     */
+    [[nodiscard]] ChunkPool* get_chunk_pool() noexcept;
+
+    /**
+     * Get the sink chunk traces are written into.
+     *
+     * @return trace writer, nullptr if tracing is disabled
+     */
+    [[nodiscard]] TraceWriter* get_trace_writer() const noexcept;
+
+    /**
+     * Export the activity of links and chunks into a Chrome trace.
+     *
+     * @param chrome_trace_writer Chrome trace sink, nullptr to disable exporting
+     */
+    void set_chrome_trace_writer(std::shared_ptr<ChromeTraceWriter> chrome_trace_writer) noexcept;
+
+    /**
+     * Get the sink the activity of links and chunks is exported into.
+     *
+     * @return Chrome trace writer, nullptr if exporting is disabled
+     */
+    [[nodiscard]] ChromeTraceWriter* get_chrome_trace_writer() const noexcept;
+
+  protected:
+    /**
+     * Constructor for contexts not driven by an EventQueue.
+     *
+     * @param trace_writer sink of chunk traces, nullptr to disable tracing
+     */
+    explicit SimulationContext(std::shared_ptr<TraceWriter> trace_writer) noexcept;
+
+  private:
+    /// event queue of the simulation
+    std::shared_ptr<EventQueue> event_queue;
+
+    /// pool the chunks of the simulation are allocated from
+    ChunkPool chunk_pool;
+
+    /// sink of chunk traces, shared by the simulations writing into the same file
+    std::shared_ptr<TraceWriter> trace_writer;
+
+    /// sink of link and chunk activity in the Chrome trace format
+    std::shared_ptr<ChromeTraceWriter> chrome_trace_writer;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -37,13 +37,18 @@ class Switch final : public BasicTopology {
      * @param bandwidth bandwidth of link
      * @param latency latency of link
      * @param base_id base id of the topology
+     * @param context simulation the topology belongs to
      */
-    Switch(int npus_count, Bandwidth bandwidth, Latency latency, const int base_id) noexcept;
+    Switch(int npus_count,
+           Bandwidth bandwidth,
+           Latency latency,
+           const int base_id,
+           std::shared_ptr<SimulationContext> context) noexcept;
 
     /**
-     * Implementation of route function in Topology.
+     * Implementation of compute_route function in Topology.
      */
-    [[nodiscard]] Route route(DeviceId src, DeviceId dest) const noexcept override;
+    [[nodiscard]] Route compute_route(DeviceId src, DeviceId dest) const noexcept override;
 
   private:
     /// node_id of the switch node
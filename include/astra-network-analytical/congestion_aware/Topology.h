@@ -8,7 +8,12 @@ LICENSE file in the root directory of this source tree.
 #include "common/EventQueue.h"
 #include "congestion_aware/Chunk.h"
 #include "congestion_aware/Device.h"
+#include "congestion_aware/LinkStore.h"
+#include "congestion_aware/Route.h"
+#include "congestion_aware/RouteCache.h"
+#include "congestion_aware/SimulationContext.h"
 #include <memory>
+#include <ostream>
 #include <vector>
 
 using namespace NetworkAnalytical;
@@ -19,18 +24,39 @@ namespace NetworkAnalyticalCongestionAware {
  * Topology abstracts a network topology.
  */
 class Topology {
+    friend class RouteCache;
+
   public:
     /**
-     * Set the event queue to be used by the topology.
+     * Set the event queue to be used by topologies constructed
+     * without an explicit SimulationContext (see construct_topology).
+     * Such topologies all share this event queue, and the trace writer if given.
      *
      * @param event_queue pointer to the event queue
+     * @param trace_writer sink of chunk traces, nullptr to disable tracing
+     */
+    static void set_event_queue(std::shared_ptr<EventQueue> event_queue,
+                                std::shared_ptr<TraceWriter> trace_writer = nullptr) noexcept;
+
+    /**
+     * Get the context set by set_event_queue.
+     *
+     * @return default simulation context
      */
-    static void set_event_queue(std::shared_ptr<EventQueue> event_queue) noexcept;
+    [[nodiscard]] static std::shared_ptr<SimulationContext> get_default_context() noexcept;
 
     /**
      * Constructor.
+     *
+     * @param base_id base id of the topology
+     * @param context simulation the topology belongs to
      */
-    Topology(int base_id) noexcept;
+    Topology(int base_id, std::shared_ptr<SimulationContext> context) noexcept;
+
+    /**
+     * Destructor.
+     */
+    virtual ~Topology() noexcept = default;
 
     /**
      * Construct the route from src to dest.
@@ -39,12 +65,97 @@ class Topology {
      *
      * e.g., route(0, 3) = [0, 5, 7, 2, 3]
      *
+     * Routes are looked up from the route cache if enabled, or computed by compute_route otherwise.
+     *
      * @param src src NPU id
      * @param dest dest NPU id
      *
      * @return route from src NPU to dest NPU
      */
-    [[nodiscard]] virtual Route route(DeviceId src, DeviceId dest) const noexcept = 0;
+    [[nodiscard]] Route route(DeviceId src, DeviceId dest) const noexcept;
+
+    /**
+     * Cache the routes of every NPU pair, so that later route() calls don't recompute them.
+     * The cache is built upon the next route() call, after the topology is fully constructed.
+     *
+     * @param memory_limit maximum memory to be used by the cached routes, in bytes
+     * @param threads_count number of threads used to build the route table
+     */
+    void enable_route_cache(size_t memory_limit = RouteCache::default_memory_limit, int threads_count = 1) noexcept;
+
+    /**
+     * Get the route cache.
+     *
+     * @return route cache, nullptr if not enabled
+     */
+    [[nodiscard]] const RouteCache* get_route_cache() const noexcept;
+
+    /**
+     * Get the simulation the topology belongs to.
+     *
+     * @return simulation context
+     */
+    [[nodiscard]] std::shared_ptr<SimulationContext> get_simulation_context() const noexcept;
+
+    /**
+     * Split chunks sent afterwards into packets of the given size,
+     * which pipeline through the hops of their routes (virtual cut-through).
+     *
+     * @param packet_size size of a packet in bytes, 0 to send chunks whole
+     */
+    void set_packet_size(ChunkSize packet_size) noexcept;
+
+    /**
+     * Get the size of a packet chunks are split into.
+     *
+     * @return size of a packet in bytes, 0 if chunks are sent whole
+     */
+    [[nodiscard]] ChunkSize get_packet_size() const noexcept;
+
+    /**
+     * Set the virtual channels of every link (see Link::set_virtual_channels).
+     * Should be set before any chunk is sent.
+     *
+     * @param virtual_channels_count number of virtual channels per link
+     * @param arbitration arbitration among the virtual channels
+     */
+    void set_virtual_channels(int virtual_channels_count, VirtualChannelArbitration arbitration) noexcept;
+
+    /**
+     * Sample the utilization of every link per each window of the given length
+     * (see Link::set_utilization_window).
+     * Should be set before any chunk is sent.
+     *
+     * @param utilization_window length of a window, 0 not to sample
+     */
+    void set_utilization_window(EventTime utilization_window) noexcept;
+
+    /**
+     * Get the utilization and queueing statistics of the link src -> dest.
+     * Every statistic is zero unless built with NETWORK_BACKEND_LINK_TELEMETRY.
+     *
+     * @param src src device id
+     * @param dest dest device id
+     * @return telemetry of the link, all zero if src and dest aren't connected
+     */
+    [[nodiscard]] LinkTelemetry get_link_telemetry(DeviceId src, DeviceId dest) const noexcept;
+
+    /**
+     * Print the telemetry of every link that carried any chunk, one line per link:
+     * src, dest, carried bytes, busy time, utilization, stalls, peak and average pending chunks.
+     * Prints nothing unless built with NETWORK_BACKEND_LINK_TELEMETRY.
+     *
+     * @param output stream to print to
+     */
+    void dump_link_telemetry(std::ostream& output) const noexcept;
+
+    /**
+     * Move the links of every device into a single LinkStore,
+     * so that devices resolve their outgoing links by array indexing.
+     * Called by the first send(), as the topology is fully constructed by then.
+     * No more links can be connected afterwards.
+     */
+    void build_link_store() noexcept;
 
     /**
      * Initiate a transmission of a chunk.
@@ -69,10 +180,16 @@ class Topology {
      */
     [[nodiscard]] int get_devices_count() const noexcept;
 
-
-
+    /**
+     * Check if the device belongs to the topology.
+     * Device ids of a topology span the contiguous range [base_id, base_id + number of devices),
+     * so the check takes constant time.
+     *
+     * @param device_id device id
+     * @return true if the topology contains the device, false otherwise
+     */
     [[nodiscard]] bool contains_device(DeviceId device_id) const noexcept;
-    
+
     /**
      * Get the number of network dimensions.
      *
@@ -107,10 +224,10 @@ class Topology {
      void instantiate_devices() noexcept;
 
     /**
-     * Get the device by device id.
+     * Get the device by device id, in constant time.
      *
      * @param device_id device id
-     * @return device
+     * @return device, nullptr if the topology doesn't contain the device
      */
     [[nodiscard]] std::shared_ptr<Device> get_device(DeviceId device_id) const noexcept;
 
@@ -135,8 +252,44 @@ class Topology {
     /// bandwidth per each network dimension
     std::vector<Bandwidth> bandwidth_per_dim;
 
+    /// id of the first device of the topology
     int base_id;
 
+    /// simulation the topology belongs to
+    std::shared_ptr<SimulationContext> context;
+
+    /// cache of NPU-to-NPU routes, nullptr if not enabled
+    std::unique_ptr<RouteCache> route_cache;
+
+    /// links of every device, nullptr until built
+    std::unique_ptr<LinkStore> link_store;
+
+    /// size of a packet chunks are split into, 0 if chunks are sent whole
+    ChunkSize packet_size;
+
+    /// number of virtual channels per link
+    int virtual_channels_count;
+
+    /// arbitration among the virtual channels of each link
+    VirtualChannelArbitration virtual_channel_arbitration;
+
+    /// length of a link utilization window, 0 if utilization isn't sampled
+    EventTime utilization_window;
+
+    /**
+     * Apply the link configurations (e.g., virtual channels, utilization window) to every link in the LinkStore.
+     */
+    void configure_links() noexcept;
+
+    /**
+     * Compute the route from src to dest.
+     *
+     * @param src src NPU id
+     * @param dest dest NPU id
+     * @return route from src NPU to dest NPU
+     */
+    [[nodiscard]] virtual Route compute_route(DeviceId src, DeviceId dest) const noexcept = 0;
+
     /**
      * Connect src -> dest with the given bandwidth and latency.
      * (i.e., a `Link` gets constructed between the two npus)
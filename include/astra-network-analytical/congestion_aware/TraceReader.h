@@ -0,0 +1,40 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "congestion_aware/TraceWriter.h"
+#include <fstream>
+#include <string>
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * TraceReader decodes a trace file written by TraceWriter, a record at a time.
+ */
+class TraceReader {
+  public:
+    /**
+     * Constructor.
+     * Exits if the file can't be opened or isn't a trace file of the supported version.
+     *
+     * @param path path of the trace file
+     */
+    explicit TraceReader(const std::string& path) noexcept;
+
+    /**
+     * Read the next record.
+     *
+     * @param record record to read into
+     * @return true if a record is read, false at the end of the file
+     */
+    [[nodiscard]] bool read(TraceRecord& record) noexcept;
+
+  private:
+    /// trace file
+    std::ifstream file;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
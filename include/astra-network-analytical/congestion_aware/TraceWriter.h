@@ -0,0 +1,182 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Type.h"
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * Trace of a chunk delivered to its destination.
+ * Records are written as is, in the byte order of the host.
+ */
+struct TraceRecord {
+    /// src device id
+    int32_t src;
+
+    /// dest device id
+    int32_t dest;
+
+    /// time the chunk is sent
+    uint64_t sent_time;
+
+    /// time the chunk arrives at its dest
+    uint64_t arrival_time;
+
+    /// number of times the chunk waited for a busy link
+    uint32_t stall_count;
+
+    /// reserved, always 0
+    uint32_t reserved;
+
+    /// total time the chunk waited for busy links
+    uint64_t stall_time;
+
+    /// size of the chunk
+    uint64_t chunk_size;
+};
+
+static_assert(sizeof(TraceRecord) == 48, "TraceRecord should have a fixed size");
+
+/**
+ * Header of a trace file, followed by the records.
+ */
+struct TraceHeader {
+    /// identifies a trace file
+    char magic[8];
+
+    /// version of the trace format
+    uint32_t version;
+
+    /// size of a record in bytes
+    uint32_t record_size;
+};
+
+static_assert(sizeof(TraceHeader) == 16, "TraceHeader should have a fixed size");
+
+/// magic of a trace file
+constexpr char trace_magic[8] = {'A', 'N', 'A', 'T', 'R', 'A', 'C', 'E'};
+
+/// version of the trace format
+constexpr uint32_t trace_version = 1;
+
+/**
+ * TraceWriter is the sink of chunk traces of a simulation (see SimulationContext),
+ * writing fixed-size binary records into a file (see TraceReader to decode).
+ *
+ * Records are buffered, and written a buffer at a time.
+ * With a background writer, a full buffer is handed over to a writer thread
+ * while the simulation fills the other one (double buffering), so that the simulation rarely waits for I/O.
+ *
+ * Records should be written by a single thread at a time.
+ */
+class TraceWriter {
+  public:
+    /// default number of records per buffer
+    static constexpr size_t default_buffer_records_count = 65'536;
+
+    /**
+     * Constructor.
+     * Exits if the file can't be opened.
+     *
+     * @param path path of the trace file
+     * @param background_writer true to write buffers from a background thread
+     * @param buffer_records_count number of records per buffer
+     */
+    explicit TraceWriter(const std::string& path,
+                         bool background_writer = false,
+                         size_t buffer_records_count = default_buffer_records_count) noexcept;
+
+    /**
+     * Destructor.
+     * Writes the buffered records.
+     */
+    ~TraceWriter() noexcept;
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    /**
+     * Append a record.
+     *
+     * @param record record to append
+     */
+    void write(const TraceRecord& record) noexcept {
+        front_buffer.push_back(record);
+        if (front_buffer.size() == buffer_records_count) {
+            flush_front_buffer();
+        }
+    }
+
+    /**
+     * Write every buffered record into the file.
+     */
+    void flush() noexcept;
+
+    /**
+     * Get the number of records written so far, including buffered ones.
+     *
+     * @return number of records
+     */
+    [[nodiscard]] uint64_t get_records_count() const noexcept;
+
+  private:
+    /// trace file
+    std::ofstream file;
+
+    /// number of records per buffer
+    size_t buffer_records_count;
+
+    /// buffer being filled by the simulation
+    std::vector<TraceRecord> front_buffer;
+
+    /// buffer being written by the writer thread, empty once written
+    std::vector<TraceRecord> back_buffer;
+
+    /// number of records in the previous buffers
+    uint64_t flushed_records_count;
+
+    /// writer thread, not joinable if buffers are written in place
+    std::thread writer;
+
+    /// guards back_buffer and stopping
+    std::mutex mutex;
+
+    /// notified when back_buffer is filled or written
+    std::condition_variable back_buffer_changed;
+
+    /// flag to stop the writer thread
+    bool stopping;
+
+    /**
+     * Write the front buffer, or hand it over to the writer thread.
+     */
+    void flush_front_buffer() noexcept;
+
+    /**
+     * Write records into the file.
+     *
+     * @param records records to write
+     */
+    void write_records(const std::vector<TraceRecord>& records) noexcept;
+
+    /**
+     * Body of the writer thread.
+     */
+    void run_writer() noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -27,13 +27,18 @@ class Tree final : public BasicTopology {
      * @param latency latency of link
      * @param bidirectional true if tree is bidirectional, false otherwise
      * @param base_id base id of the topology
+     * @param context simulation the topology belongs to
      */
-    Tree(int npus_count, Bandwidth bandwidth, Latency latency, const int base_id=0) noexcept;
+    Tree(int npus_count,
+         Bandwidth bandwidth,
+         Latency latency,
+         const int base_id,
+         std::shared_ptr<SimulationContext> context) noexcept;
 
     /**
-     * Implementation of route function in Topology.
+     * Implementation of compute_route function in Topology.
      */
-    [[nodiscard]] Route route(DeviceId src, DeviceId dest) const noexcept override;
+    [[nodiscard]] Route compute_route(DeviceId src, DeviceId dest) const noexcept override;
 
   private:
     /// true if the tree is bidirectional, false otherwise
@@ -5,17 +5,12 @@ LICENSE file in the root directory of this source tree.
 
 #pragma once
 
-#include <list>
-#include <memory>
-
 namespace NetworkAnalyticalCongestionAware {
 
 /// Forward declarations of network components
 class Chunk;
 class Link;
 class Device;
-
-/// Route is a list of devices
-using Route = std::list<std::shared_ptr<Device>>;
+class Route;
 
 }  // namespace NetworkAnalyticalCongestionAware
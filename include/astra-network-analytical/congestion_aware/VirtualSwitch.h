@@ -23,13 +23,18 @@ class VirtualSwitch final : public BasicTopology {
      * @param bandwidth bandwidth of link
      * @param latency latency of link
      * @param base_id base id of the topology
+     * @param context simulation the topology belongs to
      */
-    VirtualSwitch(int leaf_nodes_count, Bandwidth bandwidth, Latency latency, const int base_id) noexcept;
+    VirtualSwitch(int leaf_nodes_count,
+                  Bandwidth bandwidth,
+                  Latency latency,
+                  const int base_id,
+                  std::shared_ptr<SimulationContext> context) noexcept;
 
     /**
-     * Implementation of route function in Topology.
+     * Implementation of compute_route function in Topology.
      */
-    [[nodiscard]] Route route(DeviceId global_src, DeviceId global_dest) const noexcept override;
+    [[nodiscard]] Route compute_route(DeviceId global_src, DeviceId global_dest) const noexcept override;
 
     /**
      * Get the number of leaf nodes connected to the virtual switch.
@@ -7,6 +7,8 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/Type.h"
 #include "congestion_unaware/Topology.h"
+#include <cassert>
+#include <vector>
 
 using namespace NetworkAnalytical;
 
@@ -38,6 +40,48 @@ class BasicTopology : public Topology {
      */
     [[nodiscard]] EventTime send(DeviceId src, DeviceId dest, ChunkSize chunk_size) const noexcept override;
 
+    /**
+     * Implement the send_batch method of Topology.
+     * Hops are counted by a single compute_hops_counts call per block of chunks,
+     * then the delays are computed by a vectorized kernel (AVX-512 or AVX2 as the running CPU supports, scalar otherwise).
+     */
+    void send_batch(const DeviceId* srcs,
+                    const DeviceId* dests,
+                    const ChunkSize* chunk_sizes,
+                    EventTime* delays,
+                    size_t count) const noexcept override;
+
+    /**
+     * Implement the estimate_collective method of Topology.
+     *
+     * With alpha the latency of a step and beta the time per byte, each algorithm costs:
+     *   - Ring: npus_count - 1 steps of a piece per reduce-scatter or all-gather,
+     *     where a step takes the hops between ring neighbors.
+     *   - Tree: a pass of the whole buffer per level of the binary tree to reduce or broadcast,
+     *     and the pieces pipelined through the root to gather or scatter.
+     *   - HalvingDoubling: log2(npus_count) (rounded up) exchanges moving (npus_count - 1) pieces in total.
+     *   - Direct: a single step sending npus_count - 1 pieces out of each NPU.
+     * Steps of Tree, HalvingDoubling, and Direct take the hops of the farthest NPUs.
+     * All-reduce is a reduce-scatter followed by an all-gather, except on trees.
+     */
+    [[nodiscard]] EventTime estimate_collective(CollectiveType type,
+                                                CollectiveAlgorithm algorithm,
+                                                ChunkSize size) const noexcept override;
+
+    /**
+     * Precompute the link delay (i.e., hops count times latency) between every pair of NPUs into a dense table,
+     * so that send looks the link delay up instead of computing the hops count.
+     * Topologies of more than max_link_delay_table_npus_count NPUs keep computing the hops count.
+     */
+    void build_link_delay_table() noexcept;
+
+    /**
+     * Check if the link delays are looked up from a table.
+     *
+     * @return true if build_link_delay_table has tabulated the link delays, false otherwise
+     */
+    [[nodiscard]] bool has_link_delay_table() const noexcept;
+
     /**
      * Return the type of the basic topology
      * as a TopologyBuildingBlock enum class element.
@@ -46,6 +90,63 @@ class BasicTopology : public Topology {
      */
     [[nodiscard]] TopologyBuildingBlock get_basic_topology_type() const noexcept;
 
+    /**
+     * Get the latency of each link.
+     *
+     * @return latency of each link in ns
+     */
+    [[nodiscard]] Latency get_latency() const noexcept;
+
+    /**
+     * Get the bandwidth of each link in B/ns, as used for the delay computation.
+     *
+     * @return bandwidth of each link in B/ns
+     */
+    [[nodiscard]] Bandwidth get_bandwidth_Bpns() const noexcept;
+
+    /**
+     * Analytically compute the communication delay.
+     * Defined inline, as is compute_hops_count of each building block,
+     * so that a send inlines where the building block is known at compile time (see StaticMultiDimTopology).
+     *
+     * @param hops_count number of hops between src and dest
+     * @param chunk_size size of the chunk
+     * @param latency latency of each link in ns
+     * @param bandwidth_Bpns bandwidth of each link in B/ns
+     * @return communication delay to send a chunk between src and dest
+     */
+    [[nodiscard]] static EventTime compute_communication_delay(const int hops_count,
+                                                               const ChunkSize chunk_size,
+                                                               const Latency latency,
+                                                               const Bandwidth bandwidth_Bpns) noexcept {
+        assert(hops_count > 0);
+        assert(chunk_size > 0);
+        assert(chunk_size <= static_cast<ChunkSize>(INT64_MAX));
+
+        // compute link delay and serialization delay
+        // (sizes and delays fit in int64_t, whose conversions to and from double are single instructions)
+        auto link_delay = hops_count * latency;
+        auto serialization_delay = static_cast<double>(static_cast<int64_t>(chunk_size)) / bandwidth_Bpns;
+
+        // comms_delay is the summation of the two
+        auto comms_delay = link_delay + serialization_delay;
+
+        // return EventTime type of comms_delay
+        return static_cast<EventTime>(static_cast<int64_t>(comms_delay));
+    }
+
+    /**
+     * Analytically compute the communication delay over the links of the topology.
+     *
+     * @param hops_count number of hops between src and dest
+     * @param chunk_size size of the chunk
+     * @return communication delay to send a chunk between src and dest
+     */
+    [[nodiscard]] EventTime compute_communication_delay(const int hops_count,
+                                                        const ChunkSize chunk_size) const noexcept {
+        return compute_communication_delay(hops_count, chunk_size, latency, bandwidth_Bpns);
+    }
+
   protected:
     /**
      * Compute the number of hops between src and dest.
@@ -56,18 +157,54 @@ class BasicTopology : public Topology {
      */
     [[nodiscard]] virtual int compute_hops_count(DeviceId src, DeviceId dest) const noexcept = 0;
 
+    /**
+     * Compute the number of hops per each (src, dest) pair.
+     * The default implementation calls compute_hops_count per each pair;
+     * building blocks override it with a loop the compiler can vectorize.
+     *
+     * @param srcs src NPU ID per each pair
+     * @param dests dest NPU ID per each pair
+     * @param hops_counts output, number of hops per each pair
+     * @param count number of pairs
+     */
+    virtual void compute_hops_counts(const DeviceId* srcs,
+                                     const DeviceId* dests,
+                                     int* hops_counts,
+                                     size_t count) const noexcept;
+
     /// type of the basic topology
     TopologyBuildingBlock basic_topology_type;
 
+    /// largest number of NPUs whose link delays are tabulated (a table of 64K entries, 512 KB)
+    static constexpr int max_link_delay_table_npus_count = 256;
+
   private:
     /**
-     * Analytically compute the communication delay.
+     * Compute the communication delay per each chunk, the same as compute_communication_delay.
      *
-     * @param hops_count number of hops between src and dest
-     * @param chunk_size size of the chunk
-     * @return communication delay to send a chunk between src and dest
+     * @param hops_counts number of hops per each chunk
+     * @param chunk_sizes size per each chunk, below 2^52 B
+     * @param delays output, communication delay per each chunk
+     * @param count number of chunks
+     */
+    void compute_communication_delays(const int* hops_counts,
+                                      const ChunkSize* chunk_sizes,
+                                      EventTime* delays,
+                                      size_t count) const noexcept;
+
+    /**
+     * Compute the largest number of hops between neighbors of the ring 0 -> 1 -> ... -> n-1 -> 0.
+     *
+     * @return number of hops of a ring step
      */
-    [[nodiscard]] EventTime compute_communication_delay(int hops_count, ChunkSize chunk_size) const noexcept;
+    [[nodiscard]] int compute_ring_step_hops_count() const noexcept;
+
+    /**
+     * Compute the largest number of hops between any two NPUs.
+     *
+     * @return number of hops between the farthest NPUs
+     */
+    [[nodiscard]] int compute_diameter_hops_count() const noexcept;
 
     /// bandwidth of each link in GB/s
     Bandwidth bandwidth;
@@ -77,6 +214,9 @@ class BasicTopology : public Topology {
 
     /// latency of each link in ns
     Latency latency;
+
+    /// link delay in ns per each (src, dest) pair, indexed by src * npus_count + dest (empty if not tabulated)
+    std::vector<Latency> link_delay_table;
 };
 
 }  // namespace NetworkAnalyticalCongestionUnaware
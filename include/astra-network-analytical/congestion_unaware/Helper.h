@@ -17,8 +17,11 @@ namespace NetworkAnalyticalCongestionUnaware {
  * Construct a topology from a NetworkParser.
  *
  * @param network_parser NetworkParser to parse the network input file
+ * @param link_delay_tables true to look up the link delays of each dimension from a precomputed table
+ *     (see BasicTopology::build_link_delay_table), false to compute them per each send
  * @return pointer to the constructed topology
  */
-[[nodiscard]] std::shared_ptr<Topology> construct_topology(const NetworkParser& network_parser) noexcept;
+[[nodiscard]] std::shared_ptr<Topology> construct_topology(const NetworkParser& network_parser,
+                                                           bool link_delay_tables = false) noexcept;
 
 }  // namespace NetworkAnalyticalCongestionUnaware
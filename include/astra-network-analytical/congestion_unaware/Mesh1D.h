@@ -7,6 +7,8 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/Type.h"
 #include "congestion_unaware/BasicTopology.h"
+#include <cassert>
+#include <cstdlib>
 
 using namespace NetworkAnalytical;
 
@@ -23,11 +25,26 @@ class Mesh1D final : public BasicTopology {
      */
     Mesh1D(int npus_count, Bandwidth bandwidth, Latency latency) noexcept;
 
-  private:
     /**
      * Implements the compute_hops_count method of BasicTopology.
      */
-    [[nodiscard]] int compute_hops_count(DeviceId src, DeviceId dest) const noexcept override;
+    [[nodiscard]] int compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept override {
+        assert(0 <= src && src < npus_count);
+        assert(0 <= dest && dest < npus_count);
+        assert(src != dest);
+
+        // Mesh 1D distance is the absolute difference between the source and destination
+        return abs(dest - src);
+    }
+
+  private:
+    /**
+     * Implements the compute_hops_counts method of BasicTopology.
+     */
+    void compute_hops_counts(const DeviceId* srcs,
+                             const DeviceId* dests,
+                             int* hops_counts,
+                             size_t count) const noexcept override;
 };
 
 }  // namespace NetworkAnalyticalCongestionUnaware
@@ -5,9 +5,11 @@ LICENSE file in the root directory of this source tree.
 
 #pragma once
 
+#include "common/FastDivisor.h"
 #include "common/Type.h"
 #include "congestion_unaware/BasicTopology.h"
 #include "congestion_unaware/Topology.h"
+#include <array>
 #include <memory>
 
 using namespace NetworkAnalytical;
@@ -20,6 +22,9 @@ namespace NetworkAnalyticalCongestionUnaware {
  */
 class MultiDimTopology : public Topology {
   public:
+    /// maximum number of dimensions, bounding the multi-dimensional addresses on the stack
+    static constexpr int max_dims_count = 8;
+
     /**
      * Constructor.
      */
@@ -30,6 +35,50 @@ class MultiDimTopology : public Topology {
      */
     [[nodiscard]] EventTime send(DeviceId src, DeviceId dest, ChunkSize chunk_size) const noexcept override;
 
+    /**
+     * Implement the send_batch method of Topology.
+     * Per each block of chunks, the dimension and local addresses of every chunk are found first (from the top
+     * dimension down, dividing by the stride of each dimension),
+     * then the chunks are grouped by dimension (counting sort) and handed to the send_batch of each dimension at once.
+     */
+    void send_batch(const DeviceId* srcs,
+                    const DeviceId* dests,
+                    const ChunkSize* chunk_sizes,
+                    EventTime* delays,
+                    size_t count) const noexcept override;
+
+    /**
+     * Implement the estimate_collective method of Topology.
+     *
+     * The collective runs hierarchically, one dimension at a time, using the same algorithm on every dimension.
+     * Reduce-scatter goes from the first to the last dimension, each dimension working on the piece
+     * left by the previous ones (i.e., the buffer shrinks by the NPUs count of each dimension).
+     * All-gather mirrors it from the last to the first dimension, and all-reduce runs both
+     * (on trees, all-reduce reduces the whole buffer on every dimension instead).
+     * All-to-all exchanges the whole buffer on every dimension.
+     * Takes O(dims) time.
+     */
+    [[nodiscard]] EventTime estimate_collective(CollectiveType type,
+                                                CollectiveAlgorithm algorithm,
+                                                ChunkSize size) const noexcept override;
+
+    /**
+     * Estimate the time to be taken to run a collective hierarchically over the given dimensions,
+     * as described in estimate_collective.
+     *
+     * @param topology_per_dim BasicTopology instance per each dimension
+     * @param dims_count number of dimensions
+     * @param type collective pattern
+     * @param algorithm algorithm implementing the collective
+     * @param size size of the buffer of each NPU
+     * @return time to run the collective
+     */
+    [[nodiscard]] static EventTime estimate_hierarchical_collective(const BasicTopology* const* topology_per_dim,
+                                                                    int dims_count,
+                                                                    CollectiveType type,
+                                                                    CollectiveAlgorithm algorithm,
+                                                                    ChunkSize size) noexcept;
+
     /**
      * Add a dimension to the multi-dimensional topology.
      *
@@ -41,11 +90,18 @@ class MultiDimTopology : public Topology {
     /// Each NPU ID can be broken down into multiple dimensions.
     /// for example, if the topology size is [2, 8, 4] and the NPU ID is 31,
     /// then the NPU ID can be broken down into [1, 7, 1].
-    using MultiDimAddress = std::vector<DeviceId>;
+    /// Only the first dims_count entries are valid.
+    using MultiDimAddress = std::array<DeviceId, max_dims_count>;
 
     /// BasicTopology instances per dimension.
     std::vector<std::unique_ptr<BasicTopology>> topology_per_dim;
 
+    /// divisor by the number of NPUs per dimension, used for address translation
+    std::vector<FastDivisor> divisor_per_dim;
+
+    /// divisor by the number of NPUs of the lower dimensions per dimension (i.e., the stride of its addresses)
+    std::vector<FastDivisor> stride_divisor_per_dim;
+
     /**
      * Translate the NPU ID into a multi-dimensional address.
      *
@@ -7,6 +7,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/Type.h"
 #include "congestion_unaware/BasicTopology.h"
+#include <cassert>
 
 using namespace NetworkAnalytical;
 
@@ -39,11 +40,45 @@ class Ring final : public BasicTopology {
      */
     Ring(int npus_count, Bandwidth bandwidth, Latency latency, bool bidirectional = true) noexcept;
 
-  private:
     /**
      * Implements the compute_hops_count method of BasicTopology.
      */
-    [[nodiscard]] int compute_hops_count(DeviceId src, DeviceId dest) const noexcept override;
+    [[nodiscard]] int compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept override {
+        assert(0 <= src && src < npus_count);
+        assert(0 <= dest && dest < npus_count);
+        assert(src != dest);
+
+        // for Ring topology
+        // 1. compute clockwise and anti-clockwise distance
+        // 2. if unidirectional, use clockwise one
+        // 3. if bidirectional, use the shorter one
+
+        // compute clockwise distance
+        auto clockwise_distance = (dest - src);
+        if (clockwise_distance < 0) {
+            clockwise_distance += npus_count;
+        }
+
+        // compute anticlockwise distance
+        const auto anticlockwise_distance = npus_count - clockwise_distance;
+
+        // unidirectional: return clockwise distance
+        if (!bidirectional) {
+            return clockwise_distance;
+        }
+
+        // bidirectional: return shorter distance
+        return (clockwise_distance < anticlockwise_distance) ? clockwise_distance : anticlockwise_distance;
+    }
+
+  private:
+    /**
+     * Implements the compute_hops_counts method of BasicTopology.
+     */
+    void compute_hops_counts(const DeviceId* srcs,
+                             const DeviceId* dests,
+                             int* hops_counts,
+                             size_t count) const noexcept override;
 
     /// true if the ring is bidirectional, false otherwise
     bool bidirectional;
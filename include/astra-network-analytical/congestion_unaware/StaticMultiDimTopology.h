@@ -0,0 +1,263 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/FastDivisor.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_unaware/BasicTopology.h"
+#include "congestion_unaware/FullyConnected.h"
+#include "congestion_unaware/Mesh1D.h"
+#include "congestion_unaware/MultiDimTopology.h"
+#include "congestion_unaware/Ring.h"
+#include "congestion_unaware/Switch.h"
+#include "congestion_unaware/Topology.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionUnaware {
+
+/// TopologyBuildingBlock element of each building block class
+template <typename Block> constexpr auto building_block_type = TopologyBuildingBlock::Undefined;
+template <> constexpr auto building_block_type<Ring> = TopologyBuildingBlock::Ring;
+template <> constexpr auto building_block_type<FullyConnected> = TopologyBuildingBlock::FullyConnected;
+template <> constexpr auto building_block_type<Switch> = TopologyBuildingBlock::Switch;
+template <> constexpr auto building_block_type<L2Switch> = TopologyBuildingBlock::L2Switch;
+template <> constexpr auto building_block_type<L1Switch> = TopologyBuildingBlock::L1Switch;
+template <> constexpr auto building_block_type<Mesh1D> = TopologyBuildingBlock::Mesh1D;
+
+/**
+ * StaticMultiDimTopology is a multi-dimensional topology whose building blocks are known at compile time,
+ * e.g., StaticMultiDimTopology<Ring, FullyConnected, Switch>.
+ *
+ * Sends are priced the same as MultiDimTopology, but the building blocks are held by value
+ * and are final classes with inline compute_hops_count,
+ * so the address translation, the hop count, and the delay of a send all inline
+ * once the StaticMultiDimTopology type is known (e.g., through std::visit of a StaticTopology).
+ * The dimension to transfer on is found from the top dimension down, by dividing src and dest by its stride,
+ * so only the addresses of that dimension are translated and only its hops are counted.
+ *
+ * @tparam Blocks building block per each dimension, starting from the first dimension
+ */
+template <typename... Blocks> class StaticMultiDimTopology final : public Topology {
+  public:
+    /// number of dimensions
+    static constexpr int static_dims_count = sizeof...(Blocks);
+
+    static_assert(static_dims_count > 0, "at least a dimension is required");
+    static_assert(static_dims_count <= MultiDimTopology::max_dims_count, "too many dimensions");
+    static_assert((std::is_base_of_v<BasicTopology, Blocks> && ...), "building blocks should be BasicTopology");
+    static_assert((std::is_final_v<Blocks> && ...), "building blocks should be final to be devirtualized");
+
+    /**
+     * Constructor.
+     *
+     * @param npus_count_per_dim number of NPUs per each dimension
+     * @param bandwidth_per_dim bandwidth of each link per each dimension
+     * @param latency_per_dim latency of each link per each dimension
+     */
+    StaticMultiDimTopology(const std::vector<int>& npus_count_per_dim,
+                           const std::vector<Bandwidth>& bandwidth_per_dim,
+                           const std::vector<Latency>& latency_per_dim) noexcept
+        : StaticMultiDimTopology(npus_count_per_dim,
+                                 bandwidth_per_dim,
+                                 latency_per_dim,
+                                 std::index_sequence_for<Blocks...>()) {}
+
+    /**
+     * Check if the building blocks match the given ones.
+     *
+     * @param topologies_per_dim building block per each dimension
+     * @return true if the building blocks match, false otherwise
+     */
+    [[nodiscard]] static bool has_building_blocks(
+        const std::vector<TopologyBuildingBlock>& topologies_per_dim) noexcept {
+        constexpr auto building_blocks = std::array<TopologyBuildingBlock, static_dims_count>{
+            building_block_type<Blocks>...};
+        return topologies_per_dim.size() == building_blocks.size() &&
+               std::equal(building_blocks.begin(), building_blocks.end(), topologies_per_dim.begin());
+    }
+
+    /**
+     * Implement the send method of Topology.
+     */
+    [[nodiscard]] EventTime send(const DeviceId src,
+                                 const DeviceId dest,
+                                 const ChunkSize chunk_size) const noexcept override {
+        assert(0 <= src && src < npus_count);
+        assert(0 <= dest && dest < npus_count);
+        assert(src != dest);
+
+        return send(src, dest, chunk_size, std::index_sequence_for<Blocks...>());
+    }
+
+    /**
+     * Implement the send_batch method of Topology, with the send of each chunk inlined.
+     */
+    void send_batch(const DeviceId* const srcs,
+                    const DeviceId* const dests,
+                    const ChunkSize* const chunk_sizes,
+                    EventTime* const delays,
+                    const size_t count) const noexcept override {
+        for (auto i = size_t(0); i < count; i++) {
+            delays[i] = StaticMultiDimTopology::send(srcs[i], dests[i], chunk_sizes[i]);
+        }
+    }
+
+    /**
+     * Implement the estimate_collective method of Topology, the same as MultiDimTopology.
+     */
+    [[nodiscard]] EventTime estimate_collective(const CollectiveType type,
+                                                const CollectiveAlgorithm algorithm,
+                                                const ChunkSize size) const noexcept override {
+        const auto topology_per_dim = std::apply(
+            [](const auto&... dim_blocks) noexcept {
+                return std::array<const BasicTopology*, static_dims_count>{&dim_blocks...};
+            },
+            blocks);
+
+        return MultiDimTopology::estimate_hierarchical_collective(topology_per_dim.data(), static_dims_count, type,
+                                                                  algorithm, size);
+    }
+
+  private:
+    /// building block per each dimension
+    std::tuple<Blocks...> blocks;
+
+    /// divisor by the number of NPUs per dimension, used for address translation
+    std::array<FastDivisor, static_dims_count> divisor_per_dim;
+
+    /// divisor by the number of NPUs of the lower dimensions per dimension (i.e., the stride of its addresses)
+    std::array<FastDivisor, static_dims_count> stride_divisor_per_dim;
+
+    /// latency of each link per dimension
+    std::array<Latency, static_dims_count> latency_per_dim;
+
+    /// bandwidth of each link in B/ns per dimension
+    std::array<Bandwidth, static_dims_count> bandwidth_Bpns_per_dim;
+
+    /**
+     * Constructor, expanding the dimensions.
+     */
+    template <size_t... Dims>
+    StaticMultiDimTopology(const std::vector<int>& npus_count_per_dim,
+                           const std::vector<Bandwidth>& bandwidth_per_dim,
+                           const std::vector<Latency>& latency_per_dim,
+                           std::index_sequence<Dims...>) noexcept
+        : Topology(),
+          blocks(Blocks(npus_count_per_dim[Dims], bandwidth_per_dim[Dims], latency_per_dim[Dims])...),
+          divisor_per_dim{FastDivisor(npus_count_per_dim[Dims])...},
+          latency_per_dim{std::get<Dims>(blocks).get_latency()...},
+          bandwidth_Bpns_per_dim{std::get<Dims>(blocks).get_bandwidth_Bpns()...} {
+        assert(npus_count_per_dim.size() == static_dims_count);
+        assert(bandwidth_per_dim.size() == static_dims_count);
+        assert(latency_per_dim.size() == static_dims_count);
+
+        // stride of each dimension is the number of NPUs of the lower ones
+        auto stride = uint32_t(1);
+        for (auto dim = 0; dim < static_dims_count; dim++) {
+            stride_divisor_per_dim[dim] = FastDivisor(stride);
+            stride *= static_cast<uint32_t>(npus_count_per_dim[dim]);
+        }
+
+        // set topology shape
+        this->npus_count = (npus_count_per_dim[Dims] * ...);
+        this->dims_count = static_dims_count;
+        this->npus_count_per_dim = npus_count_per_dim;
+        this->bandwidth_per_dim = bandwidth_per_dim;
+    }
+
+    /**
+     * Implement send, expanding the dimensions from the top one down.
+     */
+    template <size_t... Dims>
+    [[nodiscard]] EventTime send(const DeviceId src,
+                                 const DeviceId dest,
+                                 const ChunkSize chunk_size,
+                                 std::index_sequence<Dims...>) const noexcept {
+        auto comms_delay = EventTime(0);
+        [[maybe_unused]] const auto sent =
+            (send_on<static_dims_count - 1 - Dims>(src, dest, chunk_size, comms_delay) || ...);
+        assert(sent);
+
+        return comms_delay;
+    }
+
+    /**
+     * Send a chunk on a dimension if src and dest differ on it and on none of the higher dimensions,
+     * i.e., if their quotients by the stride of the dimension differ (given that no higher dimension has sent it).
+     *
+     * @tparam Dim dimension
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @param chunk_size size of the chunk
+     * @param comms_delay output, communication delay of the chunk if sent on the dimension
+     * @return true if the chunk is sent on the dimension, false otherwise
+     */
+    template <size_t Dim>
+    [[nodiscard]] bool send_on(const DeviceId src,
+                               const DeviceId dest,
+                               const ChunkSize chunk_size,
+                               EventTime& comms_delay) const noexcept {
+        // the first dimension has the stride of 1
+        auto src_address = static_cast<uint32_t>(src);
+        auto dest_address = static_cast<uint32_t>(dest);
+        if constexpr (Dim > 0) {
+            const auto& stride_divisor = std::get<Dim>(stride_divisor_per_dim);
+            src_address = stride_divisor.divide(src_address);
+            dest_address = stride_divisor.divide(dest_address);
+        }
+        if (src_address == dest_address) {
+            return false;
+        }
+
+        // the quotients by the stride of the last dimension are its addresses already
+        if constexpr (Dim + 1 < static_dims_count) {
+            const auto& divisor = std::get<Dim>(divisor_per_dim);
+            src_address -= divisor.divide(src_address) * divisor.get_divisor();
+            dest_address -= divisor.divide(dest_address) * divisor.get_divisor();
+        }
+
+        // run localized communication
+        const auto hops_count = std::get<Dim>(blocks).compute_hops_count(static_cast<DeviceId>(src_address),
+                                                                         static_cast<DeviceId>(dest_address));
+        comms_delay = BasicTopology::compute_communication_delay(hops_count, chunk_size, std::get<Dim>(latency_per_dim),
+                                                                 std::get<Dim>(bandwidth_Bpns_per_dim));
+        return true;
+    }
+};
+
+/// Shapes pre-instantiated as StaticMultiDimTopology, selected by construct_static_topology.
+/// Single building blocks aren't: their sends are a single call already, bounded by the serialization delay division.
+using StaticTopology = std::variant<StaticMultiDimTopology<Ring, FullyConnected>,
+                                    StaticMultiDimTopology<Ring, Switch>,
+                                    StaticMultiDimTopology<FullyConnected, Switch>,
+                                    StaticMultiDimTopology<Ring, FullyConnected, Switch>,
+                                    StaticMultiDimTopology<Ring, FullyConnected, Switch, Ring>,
+                                    StaticMultiDimTopology<Ring, FullyConnected, Switch, Switch>,
+                                    StaticMultiDimTopology<Ring, FullyConnected, Switch, Ring, FullyConnected>,
+                                    StaticMultiDimTopology<Mesh1D, Ring, FullyConnected, Switch, Switch>>;
+
+/**
+ * Construct the pre-instantiated StaticMultiDimTopology whose building blocks match a NetworkParser.
+ * Other shapes should fall back to construct_topology.
+ *
+ * @param network_parser NetworkParser to parse the network input file
+ * @return the constructed topology, std::nullopt if the shape isn't pre-instantiated
+ */
+[[nodiscard]] std::optional<StaticTopology> construct_static_topology(const NetworkParser& network_parser) noexcept;
+
+}  // namespace NetworkAnalyticalCongestionUnaware
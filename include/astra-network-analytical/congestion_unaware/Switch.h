@@ -7,6 +7,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/Type.h"
 #include "congestion_unaware/BasicTopology.h"
+#include <cassert>
 
 using namespace NetworkAnalytical;
 
@@ -35,11 +36,26 @@ class Switch final : public BasicTopology {
      */
     Switch(int npus_count, Bandwidth bandwidth, Latency latency) noexcept;
 
-  private:
     /**
      * Implements the compute_hops_count method of BasicTopology.
      */
-    [[nodiscard]] int compute_hops_count(DeviceId src, DeviceId dest) const noexcept override;
+    [[nodiscard]] int compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept override {
+        assert(0 <= src && src < npus_count);
+        assert(0 <= dest && dest < npus_count);
+        assert(src != dest);
+
+        // for switch, hops_count is always 2 (src -> switch -> dest)
+        return 2;
+    }
+
+  private:
+    /**
+     * Implements the compute_hops_counts method of BasicTopology.
+     */
+    void compute_hops_counts(const DeviceId* srcs,
+                             const DeviceId* dests,
+                             int* hops_counts,
+                             size_t count) const noexcept override;
 };
 
 class L2Switch final : public BasicTopology {
@@ -53,11 +69,26 @@ class L2Switch final : public BasicTopology {
      */
     L2Switch(int npus_count, Bandwidth bandwidth, Latency latency) noexcept;
 
-  private:
     /**
      * Implements the compute_hops_count method of BasicTopology.
      */
-    [[nodiscard]] int compute_hops_count(DeviceId src, DeviceId dest) const noexcept override;
+    [[nodiscard]] int compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept override {
+        assert(0 <= src && src < npus_count);
+        assert(0 <= dest && dest < npus_count);
+        assert(src != dest);
+
+        // for L2Switch, hops_count is always 2 (src -> L2Switch -> dest)
+        return 2;
+    }
+
+  private:
+    /**
+     * Implements the compute_hops_counts method of BasicTopology.
+     */
+    void compute_hops_counts(const DeviceId* srcs,
+                             const DeviceId* dests,
+                             int* hops_counts,
+                             size_t count) const noexcept override;
 };
 
 class L1Switch final : public BasicTopology {
@@ -71,11 +102,26 @@ class L1Switch final : public BasicTopology {
      */
     L1Switch(int npus_count, Bandwidth bandwidth, Latency latency) noexcept;
 
-  private:
     /**
      * Implements the compute_hops_count method of BasicTopology.
      */
-    [[nodiscard]] int compute_hops_count(DeviceId src, DeviceId dest) const noexcept override;
+    [[nodiscard]] int compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept override {
+        assert(0 <= src && src < npus_count);
+        assert(0 <= dest && dest < npus_count);
+        assert(src != dest);
+
+        // for L1Switch, hops_count is always 4 (src -> L1Switch -> L2Switch -> L1Switch -> dest)
+        return 4;
+    }
+
+  private:
+    /**
+     * Implements the compute_hops_counts method of BasicTopology.
+     */
+    void compute_hops_counts(const DeviceId* srcs,
+                             const DeviceId* dests,
+                             int* hops_counts,
+                             size_t count) const noexcept override;
 };
 
 
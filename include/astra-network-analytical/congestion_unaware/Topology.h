@@ -6,6 +6,7 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Type.h"
+#include <cstddef>
 #include <vector>
 
 using namespace NetworkAnalytical;
@@ -33,6 +34,39 @@ class Topology {
      */
     [[nodiscard]] virtual EventTime send(DeviceId src, DeviceId dest, ChunkSize chunk_size) const noexcept = 0;
 
+    /**
+     * Estimate the time to be taken to transmit a batch of chunks, given as struct-of-arrays.
+     * delays[i] is the same as send(srcs[i], dests[i], chunk_sizes[i]).
+     * The default implementation calls send per each chunk.
+     *
+     * @param srcs src NPU ID per each chunk
+     * @param dests dest NPU ID per each chunk
+     * @param chunk_sizes size per each chunk
+     * @param delays output, time to send each chunk
+     * @param count number of chunks
+     */
+    virtual void send_batch(const DeviceId* srcs,
+                            const DeviceId* dests,
+                            const ChunkSize* chunk_sizes,
+                            EventTime* delays,
+                            size_t count) const noexcept;
+
+    /**
+     * Estimate the time to be taken to run a collective among every NPU of the topology,
+     * in closed form (i.e., without pricing each send separately).
+     *
+     * Each NPU holds a buffer of the given size (per NPU, the input of a reduction or the output of a gather,
+     * and the data sent out of each NPU for all-to-all), split into pieces of size / npus_count.
+     *
+     * @param type collective pattern
+     * @param algorithm algorithm implementing the collective
+     * @param size size of the buffer of each NPU
+     * @return time to run the collective
+     */
+    [[nodiscard]] virtual EventTime estimate_collective(CollectiveType type,
+                                                        CollectiveAlgorithm algorithm,
+                                                        ChunkSize size) const noexcept = 0;
+
     /**
      * Get the number of NPUs in the topology.
      *
@@ -62,6 +96,9 @@ class Topology {
     [[nodiscard]] std::vector<Bandwidth> get_bandwidth_per_dim() const noexcept;
 
   protected:
+    /// number of chunks processed at once by send_batch, bounding its buffers on the stack
+    static constexpr size_t batch_block_size = 256;
+
     /// number of NPUs in the topology
     int npus_count;
 
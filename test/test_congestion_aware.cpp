@@ -6,9 +6,19 @@ LICENSE file in the root directory of this source tree.
 #include "common/EventQueue.h"
 #include "common/NetworkParser.h"
 #include "common/Type.h"
+#include "congestion_aware/ChromeTraceWriter.h"
 #include "congestion_aware/Chunk.h"
+#include "congestion_aware/ChunkPool.h"
+#include "congestion_aware/Collective.h"
+#include "congestion_aware/FlowSimulation.h"
 #include "congestion_aware/Helper.h"
+#include "congestion_aware/ParallelSimulation.h"
+#include "congestion_aware/SimulationContext.h"
+#include "congestion_aware/TraceReader.h"
+#include "congestion_aware/TraceWriter.h"
+#include <cstdio>
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
@@ -28,6 +38,32 @@ class TestNetworkAnalyticalCongestionAware : public ::testing::Test {
 
     static void callback(void* const arg) {}
 
+    /**
+     * Send an All-Gather: a chunk from every NPU to every other NPU, with distinct chunk ids.
+     *
+     * @param topology topology to send the chunks through
+     * @param chunk_pool pool to create the chunks out of, nullptr to allocate them on the heap
+     */
+    void send_all_gather(const std::shared_ptr<Topology>& topology, ChunkPool* const chunk_pool = nullptr) const {
+        const auto npus_count = topology->get_npus_count();
+        auto chunk_id = 0;
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i == j) {
+                    continue;
+                }
+
+                // create a chunk and send it
+                auto route = topology->route(i, j);
+                auto chunk = (chunk_pool != nullptr)
+                                 ? chunk_pool->create_chunk(chunk_size, chunk_id, std::move(route), callback, nullptr)
+                                 : std::make_unique<Chunk>(chunk_size, chunk_id, std::move(route), callback, nullptr);
+                topology->send(std::move(chunk));
+                chunk_id++;
+            }
+        }
+    }
+
     ChunkSize chunk_size;
 };
 
@@ -38,7 +74,7 @@ TEST_F(TestNetworkAnalyticalCongestionAware, Ring) {
 
     /// message settings
     auto route = topology->route(1, 4);
-    auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+    auto chunk = std::make_unique<Chunk>(chunk_size, 0, route, callback, nullptr);
 
     // send a chunk
     topology->send(std::move(chunk));
@@ -50,7 +86,7 @@ TEST_F(TestNetworkAnalyticalCongestionAware, Ring) {
 
     /// test
     const auto simulation_time = event_queue->get_current_time();
-    EXPECT_EQ(simulation_time, 60'093);
+    EXPECT_EQ(simulation_time, 21'031);
 }
 
 TEST_F(TestNetworkAnalyticalCongestionAware, FullyConnected) {
@@ -60,7 +96,7 @@ TEST_F(TestNetworkAnalyticalCongestionAware, FullyConnected) {
 
     /// message settings
     auto route = topology->route(1, 4);
-    auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+    auto chunk = std::make_unique<Chunk>(chunk_size, 0, route, callback, nullptr);
 
     // send a chunk
     topology->send(std::move(chunk));
@@ -82,7 +118,7 @@ TEST_F(TestNetworkAnalyticalCongestionAware, Switch) {
 
     /// message settings
     auto route = topology->route(1, 4);
-    auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+    auto chunk = std::make_unique<Chunk>(chunk_size, 0, route, callback, nullptr);
 
     // send a chunk
     topology->send(std::move(chunk));
@@ -94,33 +130,384 @@ TEST_F(TestNetworkAnalyticalCongestionAware, Switch) {
 
     /// test
     const auto simulation_time = event_queue->get_current_time();
-    EXPECT_EQ(simulation_time, 40'062);
+    EXPECT_EQ(simulation_time, 20'531);
 }
 
 TEST_F(TestNetworkAnalyticalCongestionAware, AllGatherOnRing) {
     /// setup
     const auto network_parser = NetworkParser("../../input/Ring.yml");
     const auto topology = construct_topology(network_parser);
+
+    /// Run All-Gather
+    send_all_gather(topology);
+
+    /// Run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    /// test
+    const auto simulation_time = event_queue->get_current_time();
+    EXPECT_EQ(simulation_time, 352'965);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, AllGatherOnRingEventQueueTypes) {
+    /// run All-Gather on Ring with the given event queue backend
+    const auto run_all_gather = [this](const EventQueueType event_queue_type) {
+        event_queue = std::make_shared<EventQueue>(event_queue_type);
+        Topology::set_event_queue(event_queue);
+        const auto network_parser = NetworkParser("../../input/Ring.yml");
+        const auto topology = construct_topology(network_parser);
+        send_all_gather(topology);
+
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+
+        return event_queue->get_current_time();
+    };
+
+    /// test: every backend should match with the list-based event queue
+    const auto list_simulation_time = run_all_gather(EventQueueType::List);
+    const auto calendar_simulation_time = run_all_gather(EventQueueType::Calendar);
+    const auto heap_simulation_time = run_all_gather(EventQueueType::Heap);
+    EXPECT_EQ(calendar_simulation_time, list_simulation_time);
+    EXPECT_EQ(heap_simulation_time, list_simulation_time);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, EventQueueRecyclesEvents) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+
+    /// run All-Gather on Ring twice
+    auto heap_allocations_count_per_round = std::vector<uint64_t>();
+    for (int round = 0; round < 2; round++) {
+        send_all_gather(topology);
+
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+
+        heap_allocations_count_per_round.push_back(event_queue->get_memory_pool().get_heap_allocations_count());
+    }
+
+    /// test: the second round should reuse the events of the first round
+    EXPECT_EQ(event_queue->get_memory_pool().get_live_blocks_count(), 0);
+    EXPECT_EQ(heap_allocations_count_per_round[1], heap_allocations_count_per_round[0]);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, ConcurrentSimulations) {
+    /// run All-Gather on Ring within its own simulation context
+    const auto run_all_gather = [this]() {
+        const auto event_queue = std::make_shared<EventQueue>();
+        const auto context = std::make_shared<SimulationContext>(event_queue);
+        const auto network_parser = NetworkParser("../../input/Ring.yml");
+        const auto topology = construct_topology(network_parser, context);
+        send_all_gather(topology);
+
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+
+        return event_queue->get_current_time();
+    };
+
+    /// run simulations sequentially and then concurrently
+    const auto sequential_simulation_time = run_all_gather();
+    auto concurrent_simulation_times = std::vector<EventTime>(4);
+    auto threads = std::vector<std::thread>();
+    for (auto& simulation_time : concurrent_simulation_times) {
+        threads.emplace_back([&simulation_time, &run_all_gather]() { simulation_time = run_all_gather(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    /// test: simulations shouldn't interfere with each other
+    for (const auto simulation_time : concurrent_simulation_times) {
+        EXPECT_EQ(simulation_time, sequential_simulation_time);
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, ParallelSimulation) {
+    for (const auto* const network : {"../../input/Ring.yml", "../../input/Mesh1D_VirtualSwitch_SpinalSwitch.yml"}) {
+        const auto network_parser = NetworkParser(network);
+
+        /// run sequentially
+        const auto event_queue = std::make_shared<EventQueue>();
+        const auto context = std::make_shared<SimulationContext>(event_queue);
+        const auto topology = construct_topology(network_parser, context);
+        send_all_gather(topology);
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+
+        /// test: parallel simulations should match with the sequential one
+        for (const auto threads_count : {1, 2, 4}) {
+            const auto parallel_context = std::make_shared<SimulationContext>(std::make_shared<EventQueue>());
+            const auto parallel_topology = construct_topology(network_parser, parallel_context);
+            auto simulation = ParallelSimulation(parallel_topology, threads_count);
+            send_all_gather(parallel_topology);
+            simulation.run();
+
+            EXPECT_EQ(simulation.get_partitions_count(), threads_count);
+            EXPECT_EQ(simulation.get_current_time(), event_queue->get_current_time());
+
+            // transmissions across partitions take separate arrival and link-free events
+            if (threads_count == 1) {
+                EXPECT_EQ(simulation.get_events_count(), event_queue->get_scheduled_events_count());
+            } else {
+                EXPECT_GE(simulation.get_events_count(), event_queue->get_scheduled_events_count());
+            }
+        }
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, RouteCache) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
     const auto npus_count = topology->get_npus_count();
 
-    /// message settings
-    const auto chunk_size = 1'048'576;  // 1 MB
+    /// cache routes into the table, and into a cache only a few routes fit in
+    const auto table_topology = construct_topology(network_parser);
+    table_topology->enable_route_cache(RouteCache::default_memory_limit, 2);
+    const auto lru_topology = construct_topology(network_parser);
+    lru_topology->enable_route_cache(1024);
 
-    /// Run All-Gather
-    for (int i = 0; i < npus_count; i++) {
-        for (int j = 0; j < npus_count; j++) {
-            if (i == j) {
-                continue;
+    /// test: cached routes should match with the computed ones, twice
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i == j) {
+                    continue;
+                }
+
+                auto route_ids = std::vector<DeviceId>();
+                for (const auto& device : topology->route(i, j)) {
+                    route_ids.push_back(device->get_id());
+                }
+                for (const auto& cached_topology : {table_topology, lru_topology}) {
+                    auto cached_route_ids = std::vector<DeviceId>();
+                    for (const auto& device : cached_topology->route(i, j)) {
+                        cached_route_ids.push_back(device->get_id());
+                    }
+                    EXPECT_EQ(cached_route_ids, route_ids);
+                }
             }
+        }
+    }
+    EXPECT_TRUE(table_topology->get_route_cache()->is_table_built());
+    EXPECT_FALSE(lru_topology->get_route_cache()->is_table_built());
+    EXPECT_LE(lru_topology->get_route_cache()->get_memory_usage(), 1024);
 
-            // crate a chunk
-            auto route = topology->route(i, j);
-            auto* event_queue_ptr = static_cast<void*>(event_queue.get());
-            auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+    /// test: the table is built only if the whole table fits into the memory limit
+    const auto table_memory = table_topology->get_route_cache()->get_memory_usage();
+    const auto exact_topology = construct_topology(network_parser);
+    exact_topology->enable_route_cache(table_memory, 2);
+    EXPECT_EQ(exact_topology->route(0, 1).size(), 2);
+    EXPECT_TRUE(exact_topology->get_route_cache()->is_table_built());
+    const auto short_topology = construct_topology(network_parser);
+    short_topology->enable_route_cache(table_memory - 1, 2);
+    EXPECT_EQ(short_topology->route(0, 1).size(), 2);
+    EXPECT_FALSE(short_topology->get_route_cache()->is_table_built());
 
-            // send a chunk
-            topology->send(std::move(chunk));
+    /// test: once the links are bound, routes come out of the table with their ports resolved
+    table_topology->build_link_store();
+    auto route = table_topology->route(0, npus_count / 2);
+    EXPECT_TRUE(route.has_ports());
+    while (route.size() >= 2) {
+        EXPECT_EQ(route.next_port(), route.front()->get_port(route.next()->get_id()));
+        route.advance();
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, MultiDimTopology) {
+    /// setup: [2, 8, 4] NPUs, addressed by strides
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    EXPECT_EQ(topology->get_npus_count(), 64);
+    EXPECT_EQ(topology->get_devices_count(), 64 + 16);  // a switch per each group of 4 NPUs
+
+    /// test: routed along the last dimension first, 0 = [0, 0, 0] -> 48 = [0, 0, 3] -> 62 = [0, 7, 3] -> 63
+    auto route_ids = std::vector<DeviceId>();
+    for (const auto& device : topology->route(0, 63)) {
+        route_ids.push_back(device->get_id());
+    }
+    EXPECT_EQ(route_ids, (std::vector<DeviceId>{0, 64, 48, 62, 63}));
+
+    // send a chunk
+    auto chunk = std::make_unique<Chunk>(chunk_size, 0, topology->route(0, 63), callback, nullptr);
+    topology->send(std::move(chunk));
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+    // the latencies of every hop, and the serialization over the slowest (50 GB/s) links
+    EXPECT_EQ(event_queue->get_current_time(), 24'081);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, MultiDimTopologyRoutes) {
+    for (const auto* const network :
+         {"../../input/Ring_FullyConnected_Switch.yml", "../../input/Mesh1D_VirtualSwitch_SpinalSwitch.yml"}) {
+        /// setup
+        const auto network_parser = NetworkParser(network);
+        const auto topology = construct_topology(network_parser);
+        const auto npus_count = topology->get_npus_count();
+        topology->build_link_store();
+
+        /// test: every route reaches dest over connected devices
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i == j) {
+                    continue;
+                }
+
+                const auto route = topology->route(i, j);
+                EXPECT_EQ(route.front()->get_id(), i);
+                EXPECT_EQ(route.back()->get_id(), j);
+                for (auto it = route.begin(); it + 1 != route.end(); ++it) {
+                    EXPECT_NE((*it)->get_port((*(it + 1))->get_id()), -1);
+                }
+            }
+        }
+    }
+
+    /// test: NPU pairs under leaf switches 16 and 17, connected by spinal switch 18
+    const auto network_parser = NetworkParser("../../input/Mesh1D_VirtualSwitch_SpinalSwitch.yml");
+    const auto topology = construct_topology(network_parser);
+    EXPECT_EQ(topology->get_devices_count(), 16 + 3);
+    const auto expected_routes = std::vector<std::pair<std::pair<DeviceId, DeviceId>, std::vector<DeviceId>>>{
+        {{0, 1}, {0, 1}},
+        {{0, 7}, {0, 16, 7}},
+        {{0, 9}, {0, 16, 18, 17, 9}},
+    };
+    for (const auto& [pair, expected_route_ids] : expected_routes) {
+        auto route_ids = std::vector<DeviceId>();
+        for (const auto& device : topology->route(pair.first, pair.second)) {
+            route_ids.push_back(device->get_id());
+        }
+        EXPECT_EQ(route_ids, expected_route_ids);
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, MultiDimTopologyRouteCache) {
+    for (const auto* const network :
+         {"../../input/Ring_FullyConnected_Switch.yml", "../../input/Mesh1D_VirtualSwitch_SpinalSwitch.yml"}) {
+        /// setup: route table built by multiple threads
+        const auto network_parser = NetworkParser(network);
+        const auto topology = construct_topology(network_parser);
+        const auto npus_count = topology->get_npus_count();
+        const auto cached_topology = construct_topology(network_parser);
+        cached_topology->enable_route_cache(RouteCache::default_memory_limit, 4);
+
+        /// test: cached routes should match with the computed ones
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i == j) {
+                    continue;
+                }
+
+                auto route_ids = std::vector<DeviceId>();
+                for (const auto& device : topology->route(i, j)) {
+                    route_ids.push_back(device->get_id());
+                }
+                auto cached_route_ids = std::vector<DeviceId>();
+                for (const auto& device : cached_topology->route(i, j)) {
+                    cached_route_ids.push_back(device->get_id());
+                }
+                EXPECT_EQ(cached_route_ids, route_ids);
+            }
+        }
+        EXPECT_TRUE(cached_topology->get_route_cache()->is_table_built());
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, RouteCursor) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+
+    /// the longest route of the ring doesn't fit inline
+    auto route = topology->route(0, npus_count - 1);
+    ASSERT_EQ(route.size(), npus_count);
+    const auto route_copy = route;
+
+    /// test: advancing a route walks it without affecting its copy
+    for (int i = 0; i < npus_count - 1; i++) {
+        EXPECT_EQ(route.front()->get_id(), i);
+        EXPECT_EQ(route.next()->get_id(), i + 1);
+        route.advance();
+    }
+    EXPECT_EQ(route.size(), 1);
+    EXPECT_EQ(route.front(), route.back());
+    EXPECT_EQ(route_copy.size(), npus_count);
+    EXPECT_EQ(route_copy.front()->get_id(), 0);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, LinkStore) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+    topology->build_link_store();
+
+    /// test: the switch resolves the port of each NPU by its id
+    const auto switch_device = topology->get_device(npus_count);
+    ASSERT_EQ(switch_device->get_ports_count(), npus_count);
+    for (int i = 0; i < npus_count; i++) {
+        EXPECT_EQ(switch_device->get_port(i), i);
+        EXPECT_EQ(switch_device->get_neighbor(i), i);
+    }
+    EXPECT_EQ(switch_device->get_port(npus_count), -1);
+
+    /// test: each NPU has a single port, to the switch
+    const auto npu = topology->get_device(3);
+    ASSERT_EQ(npu->get_ports_count(), 1);
+    EXPECT_EQ(npu->get_port(npus_count), 0);
+    EXPECT_EQ(npu->get_port(4), -1);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, ChunkPoolRecyclesChunks) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+    auto* const chunk_pool = topology->get_simulation_context()->get_chunk_pool();
+
+    /// run All-Gather on Ring twice, with pooled chunks
+    auto heap_allocations_count_per_round = std::vector<uint64_t>();
+    for (int round = 0; round < 2; round++) {
+        send_all_gather(topology, chunk_pool);
+
+        while (!event_queue->finished()) {
+            event_queue->proceed();
         }
+
+        heap_allocations_count_per_round.push_back(chunk_pool->get_heap_allocations_count());
+    }
+
+    /// test: every chunk is recycled, and the second round reuses the chunks of the first round
+    const auto chunks_per_round = static_cast<uint64_t>(npus_count * (npus_count - 1));
+    EXPECT_EQ(chunk_pool->get_created_chunks_count(), 2 * chunks_per_round);
+    EXPECT_EQ(chunk_pool->get_live_chunks_count(), 0);
+    EXPECT_EQ(chunk_pool->get_peak_live_chunks_count(), chunks_per_round);
+    EXPECT_EQ(heap_allocations_count_per_round[1], heap_allocations_count_per_round[0]);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, FlowSimulation) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    auto flow_simulation = FlowSimulation(topology);
+
+    /// two flows share the link to NPU 0, while the third one has its links to itself
+    const auto pairs = std::vector<std::pair<DeviceId, DeviceId>>{{1, 0}, {2, 0}, {3, 4}};
+    for (const auto& [src, dest] : pairs) {
+        auto route = topology->route(src, dest);
+        auto chunk = std::make_unique<Chunk>(chunk_size, 0, route, callback, nullptr);
+        flow_simulation.send(std::move(chunk));
     }
 
     /// Run simulation
@@ -128,7 +515,317 @@ TEST_F(TestNetworkAnalyticalCongestionAware, AllGatherOnRing) {
         event_queue->proceed();
     }
 
-    /// test
-    const auto simulation_time = event_queue->get_current_time();
-    EXPECT_EQ(simulation_time, 704'116);
+    /// test: flows to NPU 0 take half the bandwidth each, plus the latency of two hops
+    // ceil(2 * 1 MB / 50 GB/s) + 2 * 500 ns, where 1 GB is 2^30 B
+    EXPECT_EQ(event_queue->get_current_time(), 40'063);
+    EXPECT_EQ(flow_simulation.get_active_flows_count(), 0);
+
+    /// test: rates are computed when the flows start, and when the flow 3 -> 4 finishes
+    EXPECT_EQ(flow_simulation.get_rate_updates_count(), 2);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, PacketPipelining) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    topology->set_packet_size(4'096);
+
+    /// message settings: 4 hops
+    auto route = topology->route(0, 4);
+    auto chunk = std::make_unique<Chunk>(chunk_size, 0, route, callback, nullptr);
+
+    // send a chunk
+    topology->send(std::move(chunk));
+
+    /// Run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    /// test: packets pipeline through the hops, in a constant number of events per hop
+    // (1 MB / 50 GB/s) + 4 * 500 ns + 3 * (4 KB / 50 GB/s), where 1 GB is 2^30 B, truncated to ns per hop
+    EXPECT_EQ(event_queue->get_current_time(), 21'759);
+    EXPECT_EQ(event_queue->get_scheduled_events_count(), 8);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, VirtualChannelPriority) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    topology->set_virtual_channels(2, VirtualChannelArbitration::Priority);
+
+    /// record the arrival time of the small chunk
+    struct Arrival {
+        EventQueue* event_queue;
+        EventTime time;
+    };
+    auto arrival = Arrival{event_queue.get(), 0};
+    const auto record_arrival = [](void* const arg) {
+        auto* const arrival = static_cast<Arrival*>(arg);
+        arrival->time = arrival->event_queue->get_current_time();
+    };
+
+    /// bulk chunks on the low-priority VC, then a small chunk on the high-priority VC, all through 1 -> switch
+    for (int i = 0; i < 4; i++) {
+        auto chunk = std::make_unique<Chunk>(chunk_size, 0, topology->route(1, 0), callback, nullptr);
+        chunk->set_virtual_channel(1);
+        topology->send(std::move(chunk));
+    }
+    auto small_chunk = std::make_unique<Chunk>(1'024, 0, topology->route(1, 0), record_arrival, &arrival);
+    topology->send(std::move(small_chunk));
+
+    /// Run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    /// test: the small chunk only waits for the bulk chunk being served, not the pending ones
+    const auto bulk_arrival_time = event_queue->get_current_time();
+    EXPECT_LT(arrival.time, bulk_arrival_time / 2);
+
+    /// test: queue occupancy per VC
+    const auto* const link = topology->get_device(1)->get_link(0);
+    const auto bulk_stats = link->get_virtual_channel_stats(1);
+    const auto small_stats = link->get_virtual_channel_stats(0);
+    EXPECT_EQ(bulk_stats.enqueued_chunks_count, 3);
+    EXPECT_EQ(bulk_stats.peak_occupancy, 3);
+    EXPECT_EQ(bulk_stats.occupancy, 0);
+    EXPECT_GT(bulk_stats.average_occupancy, small_stats.average_occupancy);
+    EXPECT_EQ(small_stats.enqueued_chunks_count, 1);
+    EXPECT_EQ(small_stats.peak_occupancy, 1);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, TransmissionCompleteEvent) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+
+    /// message settings: 4 hops
+    auto route = topology->route(0, 4);
+    auto chunk = std::make_unique<Chunk>(chunk_size, 0, route, callback, nullptr);
+
+    // send a chunk
+    topology->send(std::move(chunk));
+
+    /// Run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    /// test: each hop takes a single event, delivering the chunk and freeing the link at once
+    EXPECT_EQ(event_queue->get_scheduled_events_count(), 4);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, LinkTelemetry) {
+    if constexpr (!link_telemetry_enabled) {
+        GTEST_SKIP() << "built without NETWORK_BACKEND_LINK_TELEMETRY";
+    }
+
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto utilization_window = EventTime(10'000);
+    topology->set_utilization_window(utilization_window);
+
+    /// 4 chunks through 1 -> switch at once
+    const auto switch_id = topology->get_npus_count();
+    for (int i = 0; i < 4; i++) {
+        auto chunk = std::make_unique<Chunk>(chunk_size, 0, topology->route(1, 0), callback, nullptr);
+        topology->send(std::move(chunk));
+    }
+
+    /// Run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    /// test: 3 chunks waited for the link, which was busy until the last chunk arrived at the switch
+    const auto telemetry = topology->get_link_telemetry(1, switch_id);
+    EXPECT_EQ(telemetry.carried_bytes, 4 * chunk_size);
+    EXPECT_EQ(telemetry.stalls_count, 3);
+    EXPECT_EQ(telemetry.peak_pending_chunks_count, 3);
+    EXPECT_GT(telemetry.average_pending_chunks_count, 0);
+    EXPECT_LT(telemetry.busy_time, event_queue->get_current_time());
+
+    /// test: utilization samples add up to the busy time
+    auto sampled_busy_time = 0.0;
+    for (const auto utilization : telemetry.utilization_samples) {
+        EXPECT_LE(utilization, 1 + 1e-9);
+        sampled_busy_time += utilization * utilization_window;
+    }
+    EXPECT_NEAR(sampled_busy_time, telemetry.busy_time, 1e-3);
+
+    /// test: links not used carry nothing
+    EXPECT_EQ(topology->get_link_telemetry(2, switch_id).carried_bytes, 0);
+    EXPECT_EQ(topology->get_link_telemetry(switch_id, 0).carried_bytes, 4 * chunk_size);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, TraceWriter) {
+    const auto trace_path = std::string("trace_writer_test.bin");
+
+    /// write traces in place, and from a background writer, through buffers smaller than the trace
+    for (const auto background_writer : {false, true}) {
+        const auto trace_writer = std::make_shared<TraceWriter>(trace_path, background_writer, 16);
+        const auto context = std::make_shared<SimulationContext>(std::make_shared<EventQueue>(), trace_writer);
+        auto* const event_queue = context->get_event_queue();
+        const auto network_parser = NetworkParser("../../input/Ring.yml");
+        const auto topology = construct_topology(network_parser, context);
+        const auto npus_count = topology->get_npus_count();
+
+        /// run All-Gather on Ring
+        send_all_gather(topology);
+
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        trace_writer->flush();
+
+        /// test: a record per chunk, decoded as written
+        const auto chunks_count = npus_count * (npus_count - 1);
+        EXPECT_EQ(trace_writer->get_records_count(), chunks_count);
+
+        auto reader = TraceReader(trace_path);
+        auto record = TraceRecord();
+        auto records_count = 0;
+        auto last_arrival_time = EventTime(0);
+        while (reader.read(record)) {
+            records_count++;
+            EXPECT_NE(record.src, record.dest);
+            EXPECT_EQ(record.chunk_size, chunk_size);
+            EXPECT_LT(record.sent_time, record.arrival_time);
+            EXPECT_GE(record.arrival_time, last_arrival_time);
+            last_arrival_time = record.arrival_time;
+        }
+        EXPECT_EQ(records_count, chunks_count);
+        EXPECT_EQ(last_arrival_time, event_queue->get_current_time());
+    }
+
+    std::remove(trace_path.c_str());
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, ChromeTraceWriter) {
+    const auto trace_path = std::string("chrome_trace_writer_test.json");
+    auto links_count = 0;
+
+    {
+        /// setup
+        const auto context = std::make_shared<SimulationContext>(std::make_shared<EventQueue>());
+        auto* const event_queue = context->get_event_queue();
+        const auto network_parser = NetworkParser("../../input/Ring.yml");
+        const auto topology = construct_topology(network_parser, context);
+        context->set_chrome_trace_writer(std::make_shared<ChromeTraceWriter>(trace_path, *topology));
+        for (const auto& device : topology->get_devices()) {
+            links_count += device->get_ports_count();
+        }
+
+        /// 2 chunks through 0 -> 1 -> 2 at once, the second one waiting for the first one
+        for (int i = 0; i < 2; i++) {
+            auto chunk = std::make_unique<Chunk>(chunk_size, i, topology->route(0, 2), callback, nullptr);
+            topology->send(std::move(chunk));
+        }
+
+        /// Run simulation
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+    }
+
+    /// test: the trace is a valid JSON (hence YAML) document
+    const auto trace = YAML::LoadFile(trace_path);
+    const auto events = trace["traceEvents"];
+    ASSERT_TRUE(events.IsSequence());
+
+    auto link_tracks_count = 0;
+    auto transmissions_count = 0;
+    auto chunk_spans_count = 0;
+    auto stall_spans_count = 0;
+    auto stalls_count = 0;
+    for (const auto& event : events) {
+        const auto name = event["name"].as<std::string>();
+        const auto phase = event["ph"].as<std::string>();
+        if (name == "thread_name") {
+            link_tracks_count++;
+        } else if (phase == "X") {
+            transmissions_count++;
+        } else if (name == "stall") {
+            stall_spans_count += (phase == "b") ? 1 : 0;
+        } else if (phase == "b") {
+            chunk_spans_count++;
+            stalls_count += event["args"]["stall_count"].as<int>();
+        }
+    }
+
+    /// test: a track per link, a span per transmission, and a span per chunk with its stalls nested
+    EXPECT_EQ(link_tracks_count, links_count);
+    EXPECT_EQ(transmissions_count, 4);
+    EXPECT_EQ(chunk_spans_count, 2);
+    EXPECT_GE(stalls_count, 1);
+    EXPECT_EQ(stall_spans_count, stalls_count);
+
+    std::remove(trace_path.c_str());
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, CollectiveRingAllGather) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+
+    /// All-Gather of 1 MB pieces, as a DAG
+    const auto collective = construct_collective(CollectiveType::AllGather, CollectiveAlgorithm::Ring, npus_count,
+                                                 npus_count * chunk_size);
+    EXPECT_EQ(collective->get_sends_count(), npus_count * (npus_count - 1));
+    EXPECT_EQ(collective->get_depth(), npus_count - 1);
+
+    auto finished_count = 0;
+    collective->run(topology.get(), [](void* const arg) { (*static_cast<int*>(arg))++; }, &finished_count);
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    /// test: 15 steps of (1 MB / 50 GB/s + 500 ns), where 1 GB is 2^30 B, truncated to ns per step
+    EXPECT_EQ(finished_count, 1);
+    EXPECT_TRUE(collective->finished());
+    EXPECT_EQ(collective->get_finish_time(), 15 * 20'031);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, CollectiveAlgorithms) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+
+    const auto types = {CollectiveType::AllReduce, CollectiveType::AllGather, CollectiveType::ReduceScatter,
+                        CollectiveType::AllToAll};
+    const auto algorithms = {CollectiveAlgorithm::Ring, CollectiveAlgorithm::Tree,
+                             CollectiveAlgorithm::HalvingDoubling, CollectiveAlgorithm::Direct};
+
+    /// test: every collective runs to completion, on its own and split into slices
+    for (const auto type : types) {
+        for (const auto algorithm : algorithms) {
+            for (const auto chunks_count : {1, 4}) {
+                const auto collective = construct_collective(type, algorithm, npus_count, chunk_size, chunks_count);
+                const auto start_time = event_queue->get_current_time();
+
+                auto finished_count = 0;
+                collective->run(topology.get(), [](void* const arg) { (*static_cast<int*>(arg))++; }, &finished_count);
+                while (!event_queue->finished()) {
+                    event_queue->proceed();
+                }
+
+                EXPECT_EQ(finished_count, 1);
+                EXPECT_GT(collective->get_finish_time(), start_time);
+                EXPECT_EQ(collective->get_sends_count() % chunks_count, 0);
+            }
+        }
+    }
+
+    /// test: halving-doubling and ring move the same bytes for reduce-scatter, in fewer steps
+    const auto ring = construct_collective(CollectiveType::ReduceScatter, CollectiveAlgorithm::Ring, npus_count,
+                                           chunk_size);
+    const auto halving = construct_collective(CollectiveType::ReduceScatter, CollectiveAlgorithm::HalvingDoubling,
+                                              npus_count, chunk_size);
+    EXPECT_EQ(halving->get_sent_bytes(), ring->get_sent_bytes());
+    EXPECT_EQ(halving->get_depth(), 4);
+    EXPECT_EQ(ring->get_depth(), npus_count - 1);
 }
@@ -6,6 +6,7 @@ LICENSE file in the root directory of this source tree.
 #include "common/NetworkParser.h"
 #include "common/Type.h"
 #include "congestion_unaware/Helper.h"
+#include "congestion_unaware/StaticMultiDimTopology.h"
 #include <gtest/gtest.h>
 
 using namespace NetworkAnalytical;
@@ -68,3 +69,200 @@ TEST_F(TestNetworkAnalyticalCongestionUnaware, Ring_FullyConnected_Switch) {
     const auto comm_delay_dim3 = topology->send(26, 42, chunk_size);
     EXPECT_EQ(comm_delay_dim3, 23'531);
 }
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, CollectiveOnRing) {
+    // create network
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+
+    // ring reduce-scatter: 15 steps of a 1 MB piece between neighbors
+    const auto reduce_scatter_delay =
+        topology->estimate_collective(CollectiveType::ReduceScatter, CollectiveAlgorithm::Ring, 16 * chunk_size);
+    EXPECT_EQ(reduce_scatter_delay, 300'468);
+    EXPECT_NEAR(reduce_scatter_delay, 15 * topology->send(0, 1, chunk_size), 15);
+
+    // all-reduce is a reduce-scatter followed by an all-gather
+    const auto all_reduce_delay =
+        topology->estimate_collective(CollectiveType::AllReduce, CollectiveAlgorithm::Ring, 16 * chunk_size);
+    EXPECT_EQ(all_reduce_delay, 600'936);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, CollectiveAlgorithms) {
+    // create network
+    const auto network_parser = NetworkParser("../../input/FullyConnected.yml");
+    const auto topology = construct_topology(network_parser);
+
+    // direct all-to-all: 15 pieces of 1 MB out of each NPU at once
+    const auto all_to_all_delay =
+        topology->estimate_collective(CollectiveType::AllToAll, CollectiveAlgorithm::Direct, 16 * chunk_size);
+    EXPECT_EQ(all_to_all_delay, 293'468);
+
+    // all-reduce costs at least an all-gather, whatever the algorithm
+    for (const auto algorithm : {CollectiveAlgorithm::Ring, CollectiveAlgorithm::Tree,
+                                 CollectiveAlgorithm::HalvingDoubling, CollectiveAlgorithm::Direct}) {
+        const auto all_reduce_delay = topology->estimate_collective(CollectiveType::AllReduce, algorithm, chunk_size);
+        const auto all_gather_delay = topology->estimate_collective(CollectiveType::AllGather, algorithm, chunk_size);
+        EXPECT_GT(all_gather_delay, 0);
+        EXPECT_GE(all_reduce_delay, all_gather_delay);
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, CollectiveOnMultiDim) {
+    // create network
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+
+    // hierarchical all-gather: 64 MB on dim 1, 32 MB on dim 2, 4 MB on dim 3
+    const auto all_gather_delay =
+        topology->estimate_collective(CollectiveType::AllGather, CollectiveAlgorithm::Ring, 64 * chunk_size);
+    EXPECT_EQ(all_gather_delay, 156'300 + 276'937 + 70'593);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, SendBatch) {
+    for (const auto* const network : {"../../input/Ring.yml", "../../input/Ring_FullyConnected_Switch.yml"}) {
+        // create network
+        const auto network_parser = NetworkParser(network);
+        const auto topology = construct_topology(network_parser);
+        const auto npus_count = topology->get_npus_count();
+
+        // every (src, dest) pair, with varying chunk sizes
+        auto srcs = std::vector<DeviceId>();
+        auto dests = std::vector<DeviceId>();
+        auto chunk_sizes = std::vector<ChunkSize>();
+        for (auto src = 0; src < npus_count; src++) {
+            for (auto dest = 0; dest < npus_count; dest++) {
+                if (src != dest) {
+                    srcs.push_back(src);
+                    dests.push_back(dest);
+                    chunk_sizes.push_back(chunk_size + 997 * chunk_sizes.size());
+                }
+            }
+        }
+
+        // batched delays are the same as sending one at a time
+        auto delays = std::vector<EventTime>(srcs.size());
+        topology->send_batch(srcs.data(), dests.data(), chunk_sizes.data(), delays.data(), srcs.size());
+        for (size_t i = 0; i < srcs.size(); i++) {
+            EXPECT_EQ(delays[i], topology->send(srcs[i], dests[i], chunk_sizes[i]));
+        }
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, StaticTopology) {
+    // create network, both ways
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto static_topology = construct_static_topology(network_parser);
+    ASSERT_TRUE(static_topology.has_value());
+
+    // every send is priced the same
+    std::visit(
+        [&](const auto& static_topology) {
+            const auto npus_count = topology->get_npus_count();
+            EXPECT_EQ(static_topology.get_npus_count(), npus_count);
+            for (auto src = 0; src < npus_count; src++) {
+                for (auto dest = 0; dest < npus_count; dest++) {
+                    if (src != dest) {
+                        EXPECT_EQ(static_topology.send(src, dest, chunk_size),
+                                  topology->send(src, dest, chunk_size));
+                    }
+                }
+            }
+        },
+        *static_topology);
+
+    // single building blocks fall back to construct_topology
+    for (const auto* const network :
+         {"../../input/Ring.yml", "../../input/FullyConnected.yml", "../../input/Switch.yml"}) {
+        EXPECT_FALSE(construct_static_topology(NetworkParser(network)).has_value());
+    }
+
+    // other building blocks aren't matched
+    const auto topologies_per_dim = std::vector<TopologyBuildingBlock>{TopologyBuildingBlock::Ring,
+                                                                       TopologyBuildingBlock::FullyConnected};
+    EXPECT_FALSE((StaticMultiDimTopology<Ring, Switch>::has_building_blocks(topologies_per_dim)));
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, StaticTopologyStacks) {
+    // 5D stack, priced the same as MultiDimTopology of the same building blocks
+    const auto static_topology = StaticMultiDimTopology<Mesh1D, Ring, FullyConnected, Switch, Switch>(
+        {2, 3, 4, 2, 3}, {200, 150, 100, 50, 25}, {50, 100, 500, 1000, 2000});
+    auto topology = MultiDimTopology();
+    topology.append_dimension(std::make_unique<Mesh1D>(2, 200, 50));
+    topology.append_dimension(std::make_unique<Ring>(3, 150, 100));
+    topology.append_dimension(std::make_unique<FullyConnected>(4, 100, 500));
+    topology.append_dimension(std::make_unique<Switch>(2, 50, 1000));
+    topology.append_dimension(std::make_unique<Switch>(3, 25, 2000));
+
+    const auto npus_count = topology.get_npus_count();
+    EXPECT_EQ(static_topology.get_npus_count(), npus_count);
+    for (auto src = 0; src < npus_count; src++) {
+        for (auto dest = 0; dest < npus_count; dest++) {
+            if (src != dest) {
+                EXPECT_EQ(static_topology.send(src, dest, chunk_size), topology.send(src, dest, chunk_size));
+            }
+        }
+    }
+
+    // 4D stack
+    const auto static_topology_4d = StaticMultiDimTopology<Ring, FullyConnected, Switch, Ring>(
+        {4, 2, 3, 5}, {200, 100, 50, 25}, {50, 500, 1000, 2000});
+    auto topology_4d = MultiDimTopology();
+    topology_4d.append_dimension(std::make_unique<Ring>(4, 200, 50));
+    topology_4d.append_dimension(std::make_unique<FullyConnected>(2, 100, 500));
+    topology_4d.append_dimension(std::make_unique<Switch>(3, 50, 1000));
+    topology_4d.append_dimension(std::make_unique<Ring>(5, 25, 2000));
+
+    const auto npus_count_4d = topology_4d.get_npus_count();
+    EXPECT_EQ(static_topology_4d.get_npus_count(), npus_count_4d);
+    for (auto src = 0; src < npus_count_4d; src++) {
+        for (auto dest = 0; dest < npus_count_4d; dest++) {
+            if (src != dest) {
+                EXPECT_EQ(static_topology_4d.send(src, dest, chunk_size), topology_4d.send(src, dest, chunk_size));
+            }
+        }
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, LinkDelayTable) {
+    for (const auto* const network : {"../../input/Ring.yml", "../../input/FullyConnected.yml",
+                                      "../../input/Switch.yml", "../../input/Ring_FullyConnected_Switch.yml"}) {
+        // create network, with and without link delay tables
+        const auto network_parser = NetworkParser(network);
+        const auto topology = construct_topology(network_parser);
+        const auto tabulated_topology = construct_topology(network_parser, true);
+        const auto npus_count = topology->get_npus_count();
+
+        // tabulated delays are the same as computed ones
+        for (auto src = 0; src < npus_count; src++) {
+            for (auto dest = 0; dest < npus_count; dest++) {
+                if (src != dest) {
+                    EXPECT_EQ(tabulated_topology->send(src, dest, chunk_size), topology->send(src, dest, chunk_size));
+                }
+            }
+        }
+    }
+
+    // every building block, tabulated or not
+    auto ring = Ring(8, 50, 500);
+    auto mesh = Mesh1D(8, 50, 500);
+    auto l1_switch = L1Switch(8, 50, 500);
+    auto l2_switch = L2Switch(8, 50, 500);
+    for (auto* const topology : std::vector<BasicTopology*>{&ring, &mesh, &l1_switch, &l2_switch}) {
+        auto delays = std::vector<EventTime>();
+        for (auto dest = 1; dest < 8; dest++) {
+            delays.push_back(topology->send(0, dest, chunk_size));
+        }
+
+        topology->build_link_delay_table();
+        EXPECT_TRUE(topology->has_link_delay_table());
+        for (auto dest = 1; dest < 8; dest++) {
+            EXPECT_EQ(topology->send(0, dest, chunk_size), delays[dest - 1]);
+        }
+    }
+
+    // too large to tabulate
+    auto large_ring = Ring(1'024, 50, 500);
+    large_ring.build_link_delay_table();
+    EXPECT_FALSE(large_ring.has_link_delay_table());
+}